@@ -0,0 +1,165 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSpline.h"
+
+#include "Data/SlateSplineCustomVersion.h"
+
+bool FSlateSpline::Serialize(FArchive& Ar)
+{
+	// Undo, duplication and reference collection use memory archives that carry no custom versions,
+	// so they could not tell the two formats apart when reading back
+	if (!Ar.IsPersistent() || Ar.IsTransacting() || Ar.IsTextFormat() || Ar.HasAnyPortFlags(PPF_Duplicate))
+	{
+		return false;
+	}
+
+	Ar.UsingCustomVersion(FSlateSplineCustomVersion::GUID);
+	if (Ar.IsLoading() && Ar.CustomVer(FSlateSplineCustomVersion::GUID) < FSlateSplineCustomVersion::BulkPoints)
+	{
+		return false;
+	}
+
+	Ar << bIsLinear;
+	Ar << bIsClosedLoop;
+
+	uint8 QuantizationValue = static_cast<uint8>(Quantization);
+	Ar << QuantizationValue;
+	Quantization = static_cast<ESlateSplineQuantization>(QuantizationValue);
+
+	FSlateBrush::StaticStruct()->SerializeItem(Ar, &Brush, nullptr);
+	SerializePoints(Ar);
+
+	return true;
+}
+
+void FSlateSpline::SerializePoints(FArchive& Ar)
+{
+	int32 NumPoints = Points.Num();
+	Ar << NumPoints;
+	if (Ar.IsLoading())
+	{
+		if (NumPoints < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		Points.SetNum(NumPoints);
+	}
+
+	const auto& GetComponent = [this](int32 PointIndex, int32 Component) -> double&
+	{
+		FSlateSplinePoint& Point = Points[PointIndex];
+		return Component < 2 ? Point.Location[Component] : Point.Direction[Component - 2];
+	};
+
+	// Location X, Location Y, Direction X and Direction Y, each with its own bounds
+	for (int32 Component = 0; Component < 4; Component++)
+	{
+		double Min = 0.0;
+		double Max = 0.0;
+		if (Ar.IsSaving() && NumPoints > 0)
+		{
+			Min = Max = GetComponent(0, Component);
+			for (int32 i = 1; i < NumPoints; i++)
+			{
+				Min = FMath::Min(Min, GetComponent(i, Component));
+				Max = FMath::Max(Max, GetComponent(i, Component));
+			}
+		}
+		Ar << Min;
+		Ar << Max;
+
+		const auto& SerializeValues = [&](auto& Values, auto&& Encode, auto&& Decode)
+		{
+			if (Ar.IsSaving())
+			{
+				Values.SetNumUninitialized(NumPoints);
+				for (int32 i = 0; i < NumPoints; i++)
+				{
+					Values[i] = Encode(GetComponent(i, Component));
+				}
+			}
+
+			Values.BulkSerialize(Ar);
+
+			if (Ar.IsLoading())
+			{
+				if (Values.Num() != NumPoints)
+				{
+					Ar.SetError();
+					return;
+				}
+				for (int32 i = 0; i < NumPoints; i++)
+				{
+					GetComponent(i, Component) = Decode(Values[i]);
+				}
+			}
+		};
+
+		switch (Quantization)
+		{
+		case ESlateSplineQuantization::None:
+			{
+				TArray<double> Values;
+				SerializeValues(Values, [](double Value) { return Value; }, [](double Value) { return Value; });
+			}
+			break;
+		case ESlateSplineQuantization::Float:
+			{
+				TArray<float> Values;
+				SerializeValues(Values,
+					[Min](double Value) { return static_cast<float>(Value - Min); },
+					[Min](float Value) { return Min + Value; });
+			}
+			break;
+		case ESlateSplineQuantization::Fixed16:
+			{
+				const double Range = Max - Min;
+				const double Step = Range / MAX_uint16;
+				TArray<uint16> Values;
+				SerializeValues(Values,
+					[Min, Step](double Value) { return static_cast<uint16>(Step > 0.0 ? FMath::Clamp<int64>(FMath::RoundToInt64((Value - Min) / Step), 0, MAX_uint16) : 0); },
+					[Min, Step](uint16 Value) { return Min + Value * Step; });
+			}
+			break;
+		default:
+			Ar.SetError();
+			return;
+		}
+
+		if (Ar.IsError())
+		{
+			return;
+		}
+	}
+
+	TArray<float> Widths;
+	TArray<FLinearColor> Colors;
+	if (Ar.IsSaving())
+	{
+		Widths.Reserve(NumPoints);
+		Colors.Reserve(NumPoints);
+		for (const FSlateSplinePoint& Point : Points)
+		{
+			Widths.Add(Point.Width);
+			Colors.Add(Point.Color);
+		}
+	}
+
+	Widths.BulkSerialize(Ar);
+	Colors.BulkSerialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		if (Widths.Num() != NumPoints || Colors.Num() != NumPoints)
+		{
+			Ar.SetError();
+			return;
+		}
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			Points[i].Width = Widths[i];
+			Points[i].Color = Colors[i];
+		}
+	}
+}
@@ -2,6 +2,196 @@
 
 #include "Data/SlateSplineCurves.h"
 
+#include "Algo/BinarySearch.h"
+#include "Data/SlateSplineSegmentIndex.h"
+
+namespace SlateSplineCurves
+{
+	/** Twice the manhattan distance a Bezier curve may stray from its chord to be intersected as a line, same measure as FSplineBuilder uses. */
+	static constexpr float MaxFlatCurvinessTimesTwo = 0.5f;
+	static constexpr int32 MaxSubdivisionDepth = 16;
+
+	/** Input keys closer than this are the same crossing, found twice where a split or a point between segments falls on it. */
+	static constexpr float DuplicateInputKeyTolerance = 1.e-3f;
+
+	static bool IsFlat(const FVector2D P[4])
+	{
+		const FVector2D Deviation1 = P[0] + P[2] - 2.0 * P[1];
+		const FVector2D Deviation2 = P[1] + P[3] - 2.0 * P[2];
+		return FMath::Abs(Deviation1.X) + FMath::Abs(Deviation1.Y) + FMath::Abs(Deviation2.X) + FMath::Abs(Deviation2.Y) <= MaxFlatCurvinessTimesTwo;
+	}
+
+	/** deCasteljau split at the middle. */
+	static void Split(const FVector2D P[4], FVector2D OutLeft[4], FVector2D OutRight[4])
+	{
+		const FVector2D M = (P[1] + P[2]) * 0.5;
+		OutLeft[0] = P[0];
+		OutLeft[1] = (P[0] + P[1]) * 0.5;
+		OutLeft[2] = (OutLeft[1] + M) * 0.5;
+		OutRight[3] = P[3];
+		OutRight[2] = (P[2] + P[3]) * 0.5;
+		OutRight[1] = (M + OutRight[2]) * 0.5;
+		OutLeft[3] = OutRight[0] = (OutLeft[2] + OutRight[1]) * 0.5;
+	}
+
+	static bool IsInsideOrOn(const FBox2D& Rect, const FVector2D& Point)
+	{
+		return Point.X >= Rect.Min.X && Point.X <= Rect.Max.X && Point.Y >= Rect.Min.Y && Point.Y <= Rect.Max.Y;
+	}
+
+	/** Returns where two line segments cross, as the fraction of each segment up to the crossing. */
+	static bool IntersectLines(const FVector2D& A0, const FVector2D& A1, const FVector2D& B0, const FVector2D& B1, double& OutAlphaA, double& OutAlphaB)
+	{
+		const FVector2D DirectionA = A1 - A0;
+		const FVector2D DirectionB = B1 - B0;
+		const double Denominator = FVector2D::CrossProduct(DirectionA, DirectionB);
+		if (FMath::Abs(Denominator) < UE_SMALL_NUMBER)
+		{
+			// Parallel segments only touch where they overlap, which is not a crossing
+			return false;
+		}
+
+		const FVector2D Offset = B0 - A0;
+		OutAlphaA = FVector2D::CrossProduct(Offset, DirectionB) / Denominator;
+		OutAlphaB = FVector2D::CrossProduct(Offset, DirectionA) / Denominator;
+		return OutAlphaA >= 0.0 && OutAlphaA <= 1.0 && OutAlphaB >= 0.0 && OutAlphaB <= 1.0;
+	}
+
+	/** Subdivides the curve with the larger hull while the hulls of both overlap, until both are flat enough to intersect as lines. */
+	static void IntersectBeziers(const FVector2D A[4], float KeyA0, float KeyA1, const FVector2D B[4], float KeyB0, float KeyB1, int32 Depth, TArray<FSlateSplineIntersection>& OutIntersections)
+	{
+		const FBox2D HullA(A, 4);
+		const FBox2D HullB(B, 4);
+		if (!HullA.Intersect(HullB))
+		{
+			return;
+		}
+
+		const bool bIsFlatA = IsFlat(A);
+		const bool bIsFlatB = IsFlat(B);
+		if ((bIsFlatA && bIsFlatB) || Depth >= MaxSubdivisionDepth)
+		{
+			double AlphaA, AlphaB;
+			if (IntersectLines(A[0], A[3], B[0], B[3], AlphaA, AlphaB))
+			{
+				FSlateSplineIntersection& Intersection = OutIntersections.AddDefaulted_GetRef();
+				Intersection.Location = FMath::Lerp(A[0], A[3], AlphaA);
+				Intersection.InputKeyA = FMath::Lerp(KeyA0, KeyA1, static_cast<float>(AlphaA));
+				Intersection.InputKeyB = FMath::Lerp(KeyB0, KeyB1, static_cast<float>(AlphaB));
+			}
+			return;
+		}
+
+		FVector2D Left[4], Right[4];
+		if (!bIsFlatA && (bIsFlatB || HullA.GetArea() >= HullB.GetArea()))
+		{
+			const float KeyMid = (KeyA0 + KeyA1) * 0.5f;
+			Split(A, Left, Right);
+			IntersectBeziers(Left, KeyA0, KeyMid, B, KeyB0, KeyB1, Depth + 1, OutIntersections);
+			IntersectBeziers(Right, KeyMid, KeyA1, B, KeyB0, KeyB1, Depth + 1, OutIntersections);
+		}
+		else
+		{
+			const float KeyMid = (KeyB0 + KeyB1) * 0.5f;
+			Split(B, Left, Right);
+			IntersectBeziers(A, KeyA0, KeyA1, Left, KeyB0, KeyMid, Depth + 1, OutIntersections);
+			IntersectBeziers(A, KeyA0, KeyA1, Right, KeyMid, KeyB1, Depth + 1, OutIntersections);
+		}
+	}
+
+	/** Finds the first input key of the curve inside the rectangle, subdividing only where its hull straddles the edge of the rectangle. */
+	static bool OverlapBezierRect(const FVector2D P[4], float Key0, float Key1, const FBox2D& Rect, int32 Depth, float& OutInputKey)
+	{
+		if (!FBox2D(P, 4).Intersect(Rect))
+		{
+			return false;
+		}
+
+		if (IsInsideOrOn(Rect, P[0]))
+		{
+			OutInputKey = Key0;
+			return true;
+		}
+
+		if (IsFlat(P) || Depth >= MaxSubdivisionDepth)
+		{
+			// Clips the chord against each slab of the rectangle, the start being outside of it
+			const FVector2D Direction = P[3] - P[0];
+			double Enter = 0.0;
+			double Exit = 1.0;
+			for (int32 Axis = 0; Axis < 2; Axis++)
+			{
+				if (FMath::Abs(Direction[Axis]) < UE_SMALL_NUMBER)
+				{
+					if (P[0][Axis] < Rect.Min[Axis] || P[0][Axis] > Rect.Max[Axis])
+					{
+						return false;
+					}
+					continue;
+				}
+
+				double AlphaMin = (Rect.Min[Axis] - P[0][Axis]) / Direction[Axis];
+				double AlphaMax = (Rect.Max[Axis] - P[0][Axis]) / Direction[Axis];
+				if (AlphaMin > AlphaMax)
+				{
+					Swap(AlphaMin, AlphaMax);
+				}
+				Enter = FMath::Max(Enter, AlphaMin);
+				Exit = FMath::Min(Exit, AlphaMax);
+			}
+
+			if (Enter > Exit)
+			{
+				return false;
+			}
+			OutInputKey = FMath::Lerp(Key0, Key1, static_cast<float>(Enter));
+			return true;
+		}
+
+		FVector2D Left[4], Right[4];
+		Split(P, Left, Right);
+		const float KeyMid = (Key0 + Key1) * 0.5f;
+		return OverlapBezierRect(Left, Key0, KeyMid, Rect, Depth + 1, OutInputKey)
+			|| OverlapBezierRect(Right, KeyMid, Key1, Rect, Depth + 1, OutInputKey);
+	}
+
+	/** Bounds swept along X, with what they bound. */
+	struct FSweepEntry
+	{
+		FBox2D Box;
+		int32 Index;
+		bool bIsOther;
+	};
+
+	/**
+	 * Calls Overlap for every pair of entries whose boxes overlap, sweeping along X so only boxes spanning the same X are compared.
+	 * With bOnlyAcross, only pairs with one entry of each side are reported.
+	 */
+	template<typename OverlapType>
+	static void SweepAndPrune(TArray<FSweepEntry>& Entries, bool bOnlyAcross, OverlapType&& Overlap)
+	{
+		Entries.Sort([](const FSweepEntry& A, const FSweepEntry& B) { return A.Box.Min.X < B.Box.Min.X; });
+
+		TArray<int32> Active;
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+		{
+			const FSweepEntry& Entry = Entries[EntryIndex];
+			Active.RemoveAllSwap([&Entries, &Entry](int32 ActiveIndex) { return Entries[ActiveIndex].Box.Max.X < Entry.Box.Min.X; }, false);
+
+			for (const int32 ActiveIndex : Active)
+			{
+				const FSweepEntry& ActiveEntry = Entries[ActiveIndex];
+				if ((!bOnlyAcross || ActiveEntry.bIsOther != Entry.bIsOther)
+					&& ActiveEntry.Box.Min.Y <= Entry.Box.Max.Y && Entry.Box.Min.Y <= ActiveEntry.Box.Max.Y)
+				{
+					Overlap(ActiveEntry, Entry);
+				}
+			}
+			Active.Add(EntryIndex);
+		}
+	}
+}
+
 void FSlateSplineCurves::UpdateSpline(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment,
 	bool bLoopPositionOverride, float LoopPosition, const FVector2D& Scale2D)
 {
@@ -41,7 +231,7 @@ void FSlateSplineCurves::UpdateSpline(const FSlateSpline& InSplineRef, int32 InR
 		{
 			for (int Step = 0; Step < ReparamStepsPerSegment; Step++)
 			{
-				const float Param = Step / ReparamStepsPerSegment;
+				const float Param = static_cast<float>(Step) / ReparamStepsPerSegment;
 				const float SegmentLength = Step == 0 ? 0.0f : GetSegmentLength(SegmentIndex, Param, InSplineRef.bIsClosedLoop, Scale2D);
 				ReparamTable.Points.Emplace(SegmentLength + AccumulatedLength, SegmentIndex + Param, 0.0f, 0.0f, CIM_Linear);
 			}
@@ -49,8 +239,100 @@ void FSlateSplineCurves::UpdateSpline(const FSlateSpline& InSplineRef, int32 InR
 		}
 
 		ReparamTable.Points.Emplace(AccumulatedLength, SegmentCount, 0.0f, 0.0f, CIM_Linear);
-		++Version;
 	}
+
+	// Converted once per update, so painting, sizing and fitting the spline never convert the tangents again
+	const int32 NumSegments = FMath::Max(SegmentCount, 0);
+	BezierPoints.SetNumUninitialized(NumSegments * 4);
+	SegmentBounds.SetNumUninitialized(NumSegments);
+	Bounds.Init();
+	for (int SegmentIndex = 0; SegmentIndex < NumSegments; SegmentIndex++)
+	{
+		const FInterpCurvePointVector2D& Start = Position.Points[SegmentIndex];
+		const FInterpCurvePointVector2D& End = Position.Points[(SegmentIndex + 1) % Position.Points.Num()];
+		FVector2D* ControlPoints = &BezierPoints[SegmentIndex * 4];
+		ControlPoints[0] = Start.OutVal;
+		ControlPoints[1] = InSplineRef.bIsLinear ? Start.OutVal : Start.OutVal + Start.LeaveTangent / 3.0f;
+		ControlPoints[2] = InSplineRef.bIsLinear ? End.OutVal : End.OutVal - End.ArriveTangent / 3.0f;
+		ControlPoints[3] = End.OutVal;
+
+		SegmentBounds[SegmentIndex] = ComputeBezierBounds(ControlPoints[0], ControlPoints[1], ControlPoints[2], ControlPoints[3]);
+		Bounds += SegmentBounds[SegmentIndex];
+	}
+	if (Position.Points.Num() == 1)
+	{
+		Bounds += Position.Points[0].OutVal;
+	}
+
+	SourceHash = ComputeSourceHash(InSplineRef, InReparamStepsPerSegment, bLoopPositionOverride, LoopPosition, Scale2D);
+	++Version;
+}
+
+FBox2D FSlateSplineCurves::ComputeBezierBounds(const FVector2D& P0, const FVector2D& P1, const FVector2D& P2, const FVector2D& P3)
+{
+	FBox2D SegmentBox(ForceInit);
+	SegmentBox += P0;
+	SegmentBox += P3;
+
+	// The curve only leaves the box of its end points at the roots of its derivative, a quadratic A t^2 + B t + C on each axis
+	const FVector2D A = 3.0 * (P1 - P2) + P3 - P0;
+	const FVector2D B = 2.0 * (P0 - 2.0 * P1 + P2);
+	const FVector2D C = P1 - P0;
+	const auto AddExtremum = [&](double T)
+	{
+		if (T > 0.0 && T < 1.0)
+		{
+			const double U = 1.0 - T;
+			SegmentBox += U * U * U * P0 + 3.0 * U * U * T * P1 + 3.0 * U * T * T * P2 + T * T * T * P3;
+		}
+	};
+
+	for (int32 Axis = 0; Axis < 2; Axis++)
+	{
+		if (FMath::Abs(A[Axis]) < UE_KINDA_SMALL_NUMBER)
+		{
+			if (FMath::Abs(B[Axis]) > UE_KINDA_SMALL_NUMBER)
+			{
+				AddExtremum(-C[Axis] / B[Axis]);
+			}
+			continue;
+		}
+
+		const double Discriminant = B[Axis] * B[Axis] - 4.0 * A[Axis] * C[Axis];
+		if (Discriminant >= 0.0)
+		{
+			const double SqrtDiscriminant = FMath::Sqrt(Discriminant);
+			AddExtremum((-B[Axis] + SqrtDiscriminant) / (2.0 * A[Axis]));
+			AddExtremum((-B[Axis] - SqrtDiscriminant) / (2.0 * A[Axis]));
+		}
+	}
+
+	return SegmentBox;
+}
+
+bool FSlateSplineCurves::IsBuiltFrom(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment,
+	bool bLoopPositionOverride, float LoopPosition, const FVector2D& Scale2D) const
+{
+	return Position.Points.Num() == InSplineRef.Points.Num()
+		&& SourceHash == ComputeSourceHash(InSplineRef, InReparamStepsPerSegment, bLoopPositionOverride, LoopPosition, Scale2D);
+}
+
+uint32 FSlateSplineCurves::ComputeSourceHash(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment,
+	bool bLoopPositionOverride, float LoopPosition, const FVector2D& Scale2D)
+{
+	// Only what the curves are built from is hashed, so changing the brush, widths or colors keeps them valid
+	uint32 Hash = GetTypeHash(InReparamStepsPerSegment);
+	Hash = HashCombine(Hash, GetTypeHash(InSplineRef.bIsLinear));
+	Hash = HashCombine(Hash, GetTypeHash(InSplineRef.bIsClosedLoop));
+	Hash = HashCombine(Hash, GetTypeHash(bLoopPositionOverride));
+	Hash = HashCombine(Hash, GetTypeHash(LoopPosition));
+	Hash = HashCombine(Hash, GetTypeHash(Scale2D));
+	for (const FSlateSplinePoint& Point : InSplineRef.Points)
+	{
+		Hash = FCrc::MemCrc32(&Point.Location, sizeof(Point.Location), Hash);
+		Hash = FCrc::MemCrc32(&Point.Direction, sizeof(Point.Direction), Hash);
+	}
+	return Hash;
 }
 
 float FSlateSplineCurves::GetSegmentLength(const int32 Index, const float Param, bool bClosedLoop,
@@ -125,3 +407,273 @@ float FSlateSplineCurves::GetSplineLength() const
 {
 	return (ReparamTable.Points.Num() > 0) ? ReparamTable.Points.Last().InVal : 0.0f; 
 }
+
+float FSlateSplineCurves::GetDistanceAlongSplineAtSplineInputKey(float InKey) const
+{
+	const bool bIsClosedLoop = Position.bIsLooped;
+	const int32 NumSegments = GetNumSegments();
+
+	if (InKey >= 0 && InKey < NumSegments)
+	{
+		const int32 PointIndex = FMath::FloorToInt(InKey);
+		const float Fraction = InKey - PointIndex;
+		const int32 ReparamPointIndex = PointIndex * ReparamStepsPerSegment;
+		const float Distance = ReparamTable.Points[ReparamPointIndex].InVal;
+		return Distance + GetSegmentLength(PointIndex, Fraction, bIsClosedLoop, FVector2D(1.0f));
+	}
+
+	if (InKey >= NumSegments)
+	{
+		return GetSplineLength();
+	}
+
+	return 0.0f;
+}
+
+void FSlateSplineCurves::GetSegmentBezierPoints(int32 SegmentIndex, FVector2D OutPoints[4]) const
+{
+	if (BezierPoints.Num() == GetNumSegments() * 4)
+	{
+		FMemory::Memcpy(OutPoints, &BezierPoints[SegmentIndex * 4], sizeof(FVector2D) * 4);
+		return;
+	}
+
+	const FInterpCurvePointVector2D& Start = Position.Points[SegmentIndex];
+	const FInterpCurvePointVector2D& End = Position.Points[(SegmentIndex + 1) % Position.Points.Num()];
+	const bool bIsLinear = Start.InterpMode == CIM_Linear;
+	OutPoints[0] = Start.OutVal;
+	OutPoints[1] = bIsLinear ? Start.OutVal : Start.OutVal + Start.LeaveTangent / 3.0f;
+	OutPoints[2] = bIsLinear ? End.OutVal : End.OutVal - End.ArriveTangent / 3.0f;
+	OutPoints[3] = End.OutVal;
+}
+
+FBox2D FSlateSplineCurves::GetSegmentBounds(int32 SegmentIndex) const
+{
+	if (SegmentBounds.Num() == GetNumSegments())
+	{
+		return SegmentBounds[SegmentIndex];
+	}
+
+	FVector2D ControlPoints[4];
+	GetSegmentBezierPoints(SegmentIndex, ControlPoints);
+	return ComputeBezierBounds(ControlPoints[0], ControlPoints[1], ControlPoints[2], ControlPoints[3]);
+}
+
+void FSlateSplineCurves::FindIntersections(const FSlateSplineCurves& Other, TArray<FSlateSplineIntersection>& OutIntersections) const
+{
+	OutIntersections.Reset();
+	if (!Bounds.bIsValid || !Other.Bounds.bIsValid || !Bounds.Intersect(Other.Bounds))
+	{
+		return;
+	}
+
+	// Only segments overlapping the bounds of the other spline take part in the sweep
+	TArray<SlateSplineCurves::FSweepEntry> Entries;
+	for (int32 SegmentIndex = 0; SegmentIndex < GetNumSegments(); SegmentIndex++)
+	{
+		const FBox2D Box = GetSegmentBounds(SegmentIndex);
+		if (Box.Intersect(Other.Bounds))
+		{
+			Entries.Add({ Box, SegmentIndex, false });
+		}
+	}
+	for (int32 SegmentIndex = 0; SegmentIndex < Other.GetNumSegments(); SegmentIndex++)
+	{
+		const FBox2D Box = Other.GetSegmentBounds(SegmentIndex);
+		if (Box.Intersect(Bounds))
+		{
+			Entries.Add({ Box, SegmentIndex, true });
+		}
+	}
+
+	SlateSplineCurves::SweepAndPrune(Entries, true, [this, &Other, &OutIntersections](const SlateSplineCurves::FSweepEntry& First, const SlateSplineCurves::FSweepEntry& Second)
+	{
+		const int32 SegmentA = First.bIsOther ? Second.Index : First.Index;
+		const int32 SegmentB = First.bIsOther ? First.Index : Second.Index;
+		FVector2D ControlPointsA[4], ControlPointsB[4];
+		GetSegmentBezierPoints(SegmentA, ControlPointsA);
+		Other.GetSegmentBezierPoints(SegmentB, ControlPointsB);
+		SlateSplineCurves::IntersectBeziers(ControlPointsA, SegmentA, SegmentA + 1, ControlPointsB, SegmentB, SegmentB + 1, 0, OutIntersections);
+	});
+
+	// Crossings on a split or on a point between segments are found by both sides of it
+	OutIntersections.Sort([](const FSlateSplineIntersection& A, const FSlateSplineIntersection& B) { return A.InputKeyA < B.InputKeyA; });
+	int32 NumUnique = 0;
+	for (int32 i = 0; i < OutIntersections.Num(); i++)
+	{
+		const bool bIsDuplicate = NumUnique > 0
+			&& FMath::IsNearlyEqual(OutIntersections[i].InputKeyA, OutIntersections[NumUnique - 1].InputKeyA, SlateSplineCurves::DuplicateInputKeyTolerance)
+			&& FMath::IsNearlyEqual(OutIntersections[i].InputKeyB, OutIntersections[NumUnique - 1].InputKeyB, SlateSplineCurves::DuplicateInputKeyTolerance);
+		if (!bIsDuplicate)
+		{
+			OutIntersections[NumUnique++] = OutIntersections[i];
+		}
+	}
+	OutIntersections.SetNum(NumUnique, false);
+
+	for (FSlateSplineIntersection& Intersection : OutIntersections)
+	{
+		Intersection.DistanceA = GetDistanceAlongSplineAtSplineInputKey(Intersection.InputKeyA);
+		Intersection.DistanceB = Other.GetDistanceAlongSplineAtSplineInputKey(Intersection.InputKeyB);
+	}
+}
+
+void FSlateSplineCurves::FindIntersections(TConstArrayView<const FSlateSplineCurves*> Curves, TArray<FSlateSplineIntersection>& OutIntersections)
+{
+	OutIntersections.Reset();
+
+	TArray<SlateSplineCurves::FSweepEntry> Entries;
+	for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+	{
+		if (Curves[CurveIndex] && Curves[CurveIndex]->Bounds.bIsValid)
+		{
+			Entries.Add({ Curves[CurveIndex]->Bounds, CurveIndex, false });
+		}
+	}
+
+	TArray<FSlateSplineIntersection> PairIntersections;
+	SlateSplineCurves::SweepAndPrune(Entries, false, [&Curves, &OutIntersections, &PairIntersections](const SlateSplineCurves::FSweepEntry& First, const SlateSplineCurves::FSweepEntry& Second)
+	{
+		const int32 CurveIndexA = FMath::Min(First.Index, Second.Index);
+		const int32 CurveIndexB = FMath::Max(First.Index, Second.Index);
+		Curves[CurveIndexA]->FindIntersections(*Curves[CurveIndexB], PairIntersections);
+		for (FSlateSplineIntersection& Intersection : PairIntersections)
+		{
+			Intersection.CurveIndexA = CurveIndexA;
+			Intersection.CurveIndexB = CurveIndexB;
+		}
+		OutIntersections.Append(PairIntersections);
+	});
+}
+
+bool FSlateSplineCurves::OverlapsRect(const FBox2D& Rect, float& OutInputKey) const
+{
+	if (!Bounds.bIsValid || !Bounds.Intersect(Rect))
+	{
+		return false;
+	}
+
+	if (Position.Points.Num() == 1)
+	{
+		OutInputKey = 0.0f;
+		return SlateSplineCurves::IsInsideOrOn(Rect, Position.Points[0].OutVal);
+	}
+
+	for (int32 SegmentIndex = 0; SegmentIndex < GetNumSegments(); SegmentIndex++)
+	{
+		const FBox2D Box = GetSegmentBounds(SegmentIndex);
+		if (!Box.Intersect(Rect))
+		{
+			continue;
+		}
+
+		FVector2D ControlPoints[4];
+		GetSegmentBezierPoints(SegmentIndex, ControlPoints);
+		if (SlateSplineCurves::OverlapBezierRect(ControlPoints, SegmentIndex, SegmentIndex + 1, Rect, 0, OutInputKey))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FSlateSplineCurves::FindOverlappingRect(TConstArrayView<const FSlateSplineCurves*> Curves, const FBox2D& Rect, TArray<int32>& OutCurveIndices)
+{
+	OutCurveIndices.Reset();
+	for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+	{
+		float InputKey;
+		if (Curves[CurveIndex] && Curves[CurveIndex]->OverlapsRect(Rect, InputKey))
+		{
+			OutCurveIndices.Add(CurveIndex);
+		}
+	}
+}
+
+void FSlateSplineCurves::GetLocationsAndRotationsAtDistances(TConstArrayView<float> Distances,
+	TArrayView<FVector2D> OutLocations, TArrayView<float> OutRotationAngles) const
+{
+	check(OutLocations.Num() >= Distances.Num() && OutRotationAngles.Num() >= Distances.Num());
+
+	const TArray<FInterpCurvePointFloat>& ReparamPoints = ReparamTable.Points;
+	const int32 NumPositionPoints = Position.Points.Num();
+	if (ReparamPoints.Num() < 2 || NumPositionPoints == 0)
+	{
+		for (int32 i = 0; i < Distances.Num(); i++)
+		{
+			OutLocations[i] = NumPositionPoints > 0 ? Position.Points[0].OutVal : FVector2D::ZeroVector;
+			OutRotationAngles[i] = 0.0f;
+		}
+		return;
+	}
+
+	const int32 LastReparamIndex = ReparamPoints.Num() - 1;
+	const int32 LastSegmentIndex = Position.bIsLooped ? NumPositionPoints - 1 : NumPositionPoints - 2;
+
+	int32 ReparamIndex = 0;
+	float LastDistance = -UE_MAX_FLT;
+	for (int32 i = 0; i < Distances.Num(); i++)
+	{
+		const float Distance = FMath::Clamp(Distances[i], 0.0f, ReparamPoints.Last().InVal);
+
+		// Walk forward from the previous lookup while distances are ascending, otherwise search again
+		if (Distance < LastDistance)
+		{
+			ReparamIndex = FMath::Max(0, Algo::UpperBoundBy(ReparamPoints, Distance, &FInterpCurvePointFloat::InVal) - 1);
+		}
+		while (ReparamIndex < LastReparamIndex - 1 && ReparamPoints[ReparamIndex + 1].InVal <= Distance)
+		{
+			ReparamIndex++;
+		}
+		LastDistance = Distance;
+
+		const FInterpCurvePointFloat& ReparamStart = ReparamPoints[ReparamIndex];
+		const FInterpCurvePointFloat& ReparamEnd = ReparamPoints[ReparamIndex + 1];
+		const float StepLength = ReparamEnd.InVal - ReparamStart.InVal;
+		const float StepAlpha = StepLength > UE_SMALL_NUMBER ? (Distance - ReparamStart.InVal) / StepLength : 0.0f;
+		const float Key = FMath::Lerp(ReparamStart.OutVal, ReparamEnd.OutVal, StepAlpha);
+
+		const int32 SegmentIndex = FMath::Clamp(FMath::FloorToInt(Key), 0, LastSegmentIndex);
+		FVector2D Tangent;
+		EvalSegment(SegmentIndex, Key - SegmentIndex, OutLocations[i], Tangent);
+		OutRotationAngles[i] = Tangent.IsNearlyZero() ? 0.0f : FMath::RadiansToDegrees(FMath::Atan2(Tangent.Y, Tangent.X));
+	}
+}
+
+void FSlateSplineCurves::FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations,
+	TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const
+{
+	FSlateSplineSegmentIndex SegmentIndex;
+	SegmentIndex.Build(*this);
+	SegmentIndex.FindClosestPoints(Positions, OutLocations, OutInputKeys, OutSignedDistances);
+}
+
+void FSlateSplineCurves::EvalSegment(const int32 Index, const float Alpha, FVector2D& OutLocation, FVector2D& OutTangent) const
+{
+	const int32 NumPoints = Position.Points.Num();
+	if (NumPoints < 2 || Index >= NumPoints)
+	{
+		OutLocation = NumPoints > 0 ? Position.Points[0].OutVal : FVector2D::ZeroVector;
+		OutTangent = FVector2D::ZeroVector;
+		return;
+	}
+
+	const auto& StartPoint = Position.Points[Index];
+	const auto& EndPoint = Position.Points[Index == NumPoints - 1 ? 0 : Index + 1];
+
+	if (StartPoint.InterpMode == CIM_Linear)
+	{
+		OutLocation = FMath::Lerp(StartPoint.OutVal, EndPoint.OutVal, Alpha);
+		OutTangent = EndPoint.OutVal - StartPoint.OutVal;
+	}
+	else if (StartPoint.InterpMode == CIM_Constant)
+	{
+		OutLocation = StartPoint.OutVal;
+		OutTangent = FVector2D::ZeroVector;
+	}
+	else
+	{
+		OutLocation = FMath::CubicInterp(StartPoint.OutVal, StartPoint.LeaveTangent, EndPoint.OutVal, EndPoint.ArriveTangent, Alpha);
+		OutTangent = FMath::CubicInterpDerivative(StartPoint.OutVal, StartPoint.LeaveTangent, EndPoint.OutVal, EndPoint.ArriveTangent, Alpha);
+	}
+}
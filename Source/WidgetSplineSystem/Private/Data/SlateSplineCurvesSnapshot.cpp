@@ -0,0 +1,149 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSplineCurvesSnapshot.h"
+
+namespace SlateSplineCurvesSnapshot
+{
+	static const FSlateSplineCurves EmptyCurves;
+}
+
+const FSlateSplineCurves& FSlateSplineCurvesSnapshot::GetCurves() const
+{
+	return Curves.IsValid() ? *Curves : SlateSplineCurvesSnapshot::EmptyCurves;
+}
+
+float FSlateSplineCurvesSnapshot::GetSplineLength() const
+{
+	return GetCurves().GetSplineLength();
+}
+
+float FSlateSplineCurvesSnapshot::GetDistanceAlongSplineAtSplineInputKey(float InKey) const
+{
+	return GetCurves().GetDistanceAlongSplineAtSplineInputKey(InKey);
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetLocationAtSplineInputKey(float InKey) const
+{
+	return GetCurves().Position.Eval(InKey, FVector2D::ZeroVector);
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetTangentAtSplineInputKey(float InKey) const
+{
+	return GetCurves().Position.EvalDerivative(InKey, FVector2D::ZeroVector);
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetDirectionAtSplineInputKey(float InKey) const
+{
+	return GetTangentAtSplineInputKey(InKey).GetSafeNormal();
+}
+
+float FSlateSplineCurvesSnapshot::GetRotationAngleAtSplineInputKey(float InKey) const
+{
+	const FVector2D Direction = GetDirectionAtSplineInputKey(InKey);
+	const float AngleInRadians = Direction.IsNearlyZero() ? 0.0f : FMath::Atan2(Direction.Y, Direction.X);
+	return FMath::RadiansToDegrees(AngleInRadians);
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetLocationAtSplinePoint(int32 PointIndex) const
+{
+	return GetPositionPointSafe(PointIndex).OutVal;
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetDirectionAtSplinePoint(int32 PointIndex) const
+{
+	return GetPositionPointSafe(PointIndex).LeaveTangent.GetSafeNormal();
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetTangentAtSplinePoint(int32 PointIndex) const
+{
+	return GetPositionPointSafe(PointIndex).LeaveTangent;
+}
+
+float FSlateSplineCurvesSnapshot::GetInputKeyAtDistanceAlongSpline(float Distance) const
+{
+	const FSlateSplineCurves& SplineCurves = GetCurves();
+	if (SplineCurves.Position.Points.Num() < 2)
+	{
+		return 0.0f;
+	}
+
+	return SplineCurves.ReparamTable.Eval(Distance, 0.0f);
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetLocationAtDistanceAlongSpline(float Distance) const
+{
+	return GetLocationAtSplineInputKey(GetCurves().ReparamTable.Eval(Distance, 0.0f));
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetDirectionAtDistanceAlongSpline(float Distance) const
+{
+	return GetDirectionAtSplineInputKey(GetCurves().ReparamTable.Eval(Distance, 0.0f));
+}
+
+FVector2D FSlateSplineCurvesSnapshot::GetTangentAtDistanceAlongSpline(float Distance) const
+{
+	return GetTangentAtSplineInputKey(GetCurves().ReparamTable.Eval(Distance, 0.0f));
+}
+
+float FSlateSplineCurvesSnapshot::GetRotationAngleAtDistanceAlongSpline(float Distance) const
+{
+	return GetRotationAngleAtSplineInputKey(GetCurves().ReparamTable.Eval(Distance, 0.0f));
+}
+
+void FSlateSplineCurvesSnapshot::FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations,
+	TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const
+{
+	GetCurves().FindClosestPoints(Positions, OutLocations, OutInputKeys, OutSignedDistances);
+}
+
+const FInterpCurvePointVector2D& FSlateSplineCurvesSnapshot::GetPositionPointSafe(int32 PointIndex) const
+{
+	const FSlateSplineCurves& SplineCurves = GetCurves();
+	const TArray<FInterpCurvePointVector2D>& Points = SplineCurves.Position.Points;
+	const int32 NumPoints = Points.Num();
+	if (NumPoints > 0)
+	{
+		const int32 ClampedIndex = (SplineCurves.Position.bIsLooped && PointIndex >= NumPoints) ? 0 : FMath::Clamp(PointIndex, 0, NumPoints - 1);
+		return Points[ClampedIndex];
+	}
+
+	static const FInterpCurvePointVector2D DefaultPoint(0.0f, FVector2D::ZeroVector, FVector2D::ZeroVector, FVector2D::ZeroVector, CIM_Constant);
+	return DefaultPoint;
+}
+
+FSlateSplineCurvesPublisher::~FSlateSplineCurvesPublisher()
+{
+	// The widget is only destroyed once nothing can read from it anymore
+	delete Published.exchange(nullptr);
+}
+
+void FSlateSplineCurvesPublisher::Publish(const TSharedPtr<const FSlateSplineCurves>& InCurves)
+{
+	Curves = InCurves;
+
+	FPublishedCurves* Previous = Published.exchange(new FPublishedCurves{InCurves});
+	if (Previous)
+	{
+		Retired.Emplace(Previous);
+	}
+	ReleaseRetired();
+}
+
+void FSlateSplineCurvesPublisher::ReleaseRetired()
+{
+	// A reader counts itself before loading the entry, so once none are counted after the exchange, every later one loads the new entry.
+	// While readers keep coming, the retired entries wait for the next publish.
+	if (Retired.Num() > 0 && NumActiveReaders.load() == 0)
+	{
+		Retired.Reset();
+	}
+}
+
+FSlateSplineCurvesSnapshot FSlateSplineCurvesPublisher::GetSnapshot() const
+{
+	NumActiveReaders.fetch_add(1);
+	const FPublishedCurves* Current = Published.load();
+	FSlateSplineCurvesSnapshot Snapshot(Current ? Current->Curves : TSharedPtr<const FSlateSplineCurves>());
+	NumActiveReaders.fetch_sub(1, std::memory_order_release);
+	return Snapshot;
+}
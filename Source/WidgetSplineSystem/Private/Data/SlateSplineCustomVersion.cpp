@@ -0,0 +1,9 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSplineCustomVersion.h"
+
+#include "Serialization/CustomVersion.h"
+
+const FGuid FSlateSplineCustomVersion::GUID(0x118C3F39, 0x4BBB49DD, 0xAD5A6979, 0xCA9F173D);
+
+static FCustomVersionRegistration GRegisterSlateSplineCustomVersion(FSlateSplineCustomVersion::GUID, FSlateSplineCustomVersion::LatestVersion, TEXT("SlateSplineVer"));
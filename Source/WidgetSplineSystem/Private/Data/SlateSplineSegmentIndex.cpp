@@ -0,0 +1,216 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSplineSegmentIndex.h"
+
+#include "Async/ParallelFor.h"
+
+namespace SlateSplineSegmentIndex
+{
+	/** Twice the manhattan distance the flattened curve may stray from the curve, same measure as FSplineBuilder uses. */
+	static constexpr float MaxCurvinessTimesTwo = 1.0f;
+	static constexpr int32 MaxSubdivisionDepth = 8;
+
+	/** Positions queried by each task of a batch, so small batches do not pay for waking workers. */
+	static constexpr int32 PositionsPerTask = 256;
+
+	/** Adds the end points of the flattened Bezier curve between T0 and T1, the start point being added already. */
+	static void Flatten(const FVector2D& P0, const FVector2D& P1, const FVector2D& P2, const FVector2D& P3, float T0, float T1, int32 Depth, TArray<TPair<FVector2D, float>>& OutPoints)
+	{
+		const FVector2D Deviation1 = P0 + P2 - 2.0 * P1;
+		const FVector2D Deviation2 = P1 + P3 - 2.0 * P2;
+		const float Curviness = FMath::Abs(Deviation1.X) + FMath::Abs(Deviation1.Y) + FMath::Abs(Deviation2.X) + FMath::Abs(Deviation2.Y);
+		if (Curviness <= MaxCurvinessTimesTwo || Depth >= MaxSubdivisionDepth)
+		{
+			OutPoints.Emplace(P3, T1);
+			return;
+		}
+
+		// deCasteljau split at the middle
+		const FVector2D L1 = (P0 + P1) * 0.5;
+		const FVector2D M = (P1 + P2) * 0.5;
+		const FVector2D R2 = (P2 + P3) * 0.5;
+		const FVector2D L2 = (L1 + M) * 0.5;
+		const FVector2D R1 = (M + R2) * 0.5;
+		const FVector2D Mid = (L2 + R1) * 0.5;
+		const float TMid = (T0 + T1) * 0.5f;
+
+		Flatten(P0, L1, L2, Mid, T0, TMid, Depth + 1, OutPoints);
+		Flatten(Mid, R1, R2, P3, TMid, T1, Depth + 1, OutPoints);
+	}
+}
+
+void FSlateSplineSegmentIndex::Build(const FSlateSplineCurves& Curves)
+{
+	Locations.Reset();
+	InputKeys.Reset();
+	Levels.Reset();
+	bIsClosedLoop = Curves.Position.bIsLooped;
+
+	if (Curves.Position.Points.Num() < 2)
+	{
+		return;
+	}
+
+	TArray<TPair<FVector2D, float>> SegmentPoints;
+	for (int32 SegmentIndex = 0; SegmentIndex < Curves.GetNumSegments(); SegmentIndex++)
+	{
+		FVector2D ControlPoints[4];
+		Curves.GetSegmentBezierPoints(SegmentIndex, ControlPoints);
+
+		SegmentPoints.Reset();
+		SegmentPoints.Emplace(ControlPoints[0], 0.0f);
+		SlateSplineSegmentIndex::Flatten(ControlPoints[0], ControlPoints[1], ControlPoints[2], ControlPoints[3], 0.0f, 1.0f, 0, SegmentPoints);
+
+		// The segment start was already added as the end of the previous segment, except for the very first one
+		for (int32 i = Locations.Num() > 0 ? 1 : 0; i < SegmentPoints.Num(); i++)
+		{
+			Locations.Add(SegmentPoints[i].Key);
+			InputKeys.Add(SegmentIndex + SegmentPoints[i].Value);
+		}
+	}
+
+	const int32 NumSegments = GetNumSegments();
+	TArray<FBox2D>& Leaves = Levels.AddDefaulted_GetRef();
+	Leaves.SetNum(FMath::DivideAndRoundUp(NumSegments, LeafSize));
+	for (int32 LeafIndex = 0; LeafIndex < Leaves.Num(); LeafIndex++)
+	{
+		FBox2D& LeafBounds = Leaves[LeafIndex];
+		LeafBounds.Init();
+		const int32 LastVertex = FMath::Min((LeafIndex + 1) * LeafSize, NumSegments);
+		for (int32 VertexIndex = LeafIndex * LeafSize; VertexIndex <= LastVertex; VertexIndex++)
+		{
+			LeafBounds += Locations[VertexIndex];
+		}
+	}
+
+	while (Levels.Last().Num() > 1)
+	{
+		const int32 NumChildren = Levels.Last().Num();
+		TArray<FBox2D> Parents;
+		Parents.SetNum(FMath::DivideAndRoundUp(NumChildren, 2));
+		for (int32 ParentIndex = 0; ParentIndex < Parents.Num(); ParentIndex++)
+		{
+			const TArray<FBox2D>& Children = Levels.Last();
+			Parents[ParentIndex] = Children[ParentIndex * 2];
+			if (ParentIndex * 2 + 1 < NumChildren)
+			{
+				Parents[ParentIndex] += Children[ParentIndex * 2 + 1];
+			}
+		}
+		Levels.Add(MoveTemp(Parents));
+	}
+}
+
+bool FSlateSplineSegmentIndex::FindClosestPoint(const FVector2D& Position, FVector2D& OutLocation, float& OutInputKey, float& OutSignedDistance) const
+{
+	if (Levels.Num() == 0)
+	{
+		return false;
+	}
+
+	double ClosestSquaredDistance = TNumericLimits<double>::Max();
+	int32 ClosestSegment = 0;
+	double ClosestAlpha = 0.0;
+
+	// Nodes farther than the closest segment found so far are skipped, and the nearer child is visited first to find it early
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+	Stack.Emplace(Levels.Num() - 1, 0);
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Node = Stack.Pop(false);
+		if (Levels[Node.Key][Node.Value].ComputeSquaredDistanceToPoint(Position) >= ClosestSquaredDistance)
+		{
+			continue;
+		}
+
+		if (Node.Key > 0)
+		{
+			const TArray<FBox2D>& Children = Levels[Node.Key - 1];
+			const int32 FirstChild = Node.Value * 2;
+			if (FirstChild + 1 < Children.Num())
+			{
+				const bool bIsFirstNearer = Children[FirstChild].ComputeSquaredDistanceToPoint(Position) <= Children[FirstChild + 1].ComputeSquaredDistanceToPoint(Position);
+				Stack.Emplace(Node.Key - 1, bIsFirstNearer ? FirstChild + 1 : FirstChild);
+				Stack.Emplace(Node.Key - 1, bIsFirstNearer ? FirstChild : FirstChild + 1);
+			}
+			else
+			{
+				Stack.Emplace(Node.Key - 1, FirstChild);
+			}
+			continue;
+		}
+
+		const int32 LastSegment = FMath::Min((Node.Value + 1) * LeafSize, GetNumSegments());
+		for (int32 SegmentIndex = Node.Value * LeafSize; SegmentIndex < LastSegment; SegmentIndex++)
+		{
+			const FVector2D& Start = Locations[SegmentIndex];
+			const FVector2D Segment = Locations[SegmentIndex + 1] - Start;
+			const double SquaredLength = Segment.SizeSquared();
+			const double Alpha = SquaredLength > UE_SMALL_NUMBER ? FMath::Clamp(FVector2D::DotProduct(Position - Start, Segment) / SquaredLength, 0.0, 1.0) : 0.0;
+			const double SquaredDistance = FVector2D::DistSquared(Position, Start + Segment * Alpha);
+			if (SquaredDistance < ClosestSquaredDistance)
+			{
+				ClosestSquaredDistance = SquaredDistance;
+				ClosestSegment = SegmentIndex;
+				ClosestAlpha = Alpha;
+			}
+		}
+	}
+
+	const FVector2D& Start = Locations[ClosestSegment];
+	const FVector2D& End = Locations[ClosestSegment + 1];
+	OutLocation = FMath::Lerp(Start, End, ClosestAlpha);
+	OutInputKey = FMath::Lerp(InputKeys[ClosestSegment], InputKeys[ClosestSegment + 1], static_cast<float>(ClosestAlpha));
+
+	// Closest to a vertex shared by two segments, the side is taken from both, so positions around the outside of a corner get the same sign
+	const int32 NumSegments = GetNumSegments();
+	FVector2D Direction = (End - Start).GetSafeNormal();
+	if (ClosestAlpha <= 0.0 && (ClosestSegment > 0 || bIsClosedLoop))
+	{
+		const int32 PreviousSegment = (ClosestSegment + NumSegments - 1) % NumSegments;
+		Direction += (Locations[PreviousSegment + 1] - Locations[PreviousSegment]).GetSafeNormal();
+	}
+	else if (ClosestAlpha >= 1.0 && (ClosestSegment + 1 < NumSegments || bIsClosedLoop))
+	{
+		const int32 NextSegment = (ClosestSegment + 1) % NumSegments;
+		Direction += (Locations[NextSegment + 1] - Locations[NextSegment]).GetSafeNormal();
+	}
+
+	const float Distance = FMath::Sqrt(ClosestSquaredDistance);
+	OutSignedDistance = FVector2D::CrossProduct(Direction, Position - OutLocation) < 0.0 ? -Distance : Distance;
+	return true;
+}
+
+void FSlateSplineSegmentIndex::FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations, TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const
+{
+	check(OutLocations.Num() == 0 || OutLocations.Num() == Positions.Num());
+	check(OutInputKeys.Num() == 0 || OutInputKeys.Num() == Positions.Num());
+	check(OutSignedDistances.Num() == 0 || OutSignedDistances.Num() == Positions.Num());
+
+	const int32 NumTasks = FMath::DivideAndRoundUp(Positions.Num(), SlateSplineSegmentIndex::PositionsPerTask);
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
+	{
+		const int32 FirstPosition = TaskIndex * SlateSplineSegmentIndex::PositionsPerTask;
+		const int32 LastPosition = FMath::Min(FirstPosition + SlateSplineSegmentIndex::PositionsPerTask, Positions.Num());
+		for (int32 i = FirstPosition; i < LastPosition; i++)
+		{
+			FVector2D Location = Positions[i];
+			float InputKey = 0.0f;
+			float SignedDistance = 0.0f;
+			FindClosestPoint(Positions[i], Location, InputKey, SignedDistance);
+
+			if (OutLocations.Num() > 0)
+			{
+				OutLocations[i] = Location;
+			}
+			if (OutInputKeys.Num() > 0)
+			{
+				OutInputKeys[i] = InputKey;
+			}
+			if (OutSignedDistances.Num() > 0)
+			{
+				OutSignedDistances[i] = SignedDistance;
+			}
+		}
+	}, NumTasks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
@@ -0,0 +1,260 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SplineStrokeFitter.h"
+
+// Direction = 3 * (P1 - P0), the same control point scale the spline builder and Slate use
+static constexpr double BezierControlPointScale = 3.0;
+
+// Segments are closed once they span this many samples, which bounds the cost of a single sample
+static constexpr int32 MaxSamplesPerSegment = 64;
+
+// Samples away from the ends used to estimate the end tangents, so the jitter of the last sample does not dominate them
+static constexpr int32 TangentSampleOffset = 3;
+
+static constexpr int32 MaxReparameterizations = 4;
+
+FSplineStrokeFitter::FSplineStrokeFitter(float InMaxError, float InMinSampleDistance)
+{
+	Reset(InMaxError, InMinSampleDistance);
+}
+
+void FSplineStrokeFitter::Reset()
+{
+	Points.Reset();
+	Samples.Reset();
+	SampleLengths.Reset();
+	bHasOpenCubic = false;
+	bHasStartHandle = false;
+	NumSamples = 0;
+}
+
+void FSplineStrokeFitter::Reset(float InMaxError, float InMinSampleDistance)
+{
+	MaxErrorSquared = FMath::Square(FMath::Max(InMaxError, UE_KINDA_SMALL_NUMBER));
+	MinSampleDistance = FMath::Max(InMinSampleDistance, UE_KINDA_SMALL_NUMBER);
+	Reset();
+}
+
+void FSplineStrokeFitter::AddSample(const FVector2D& Location)
+{
+	if (Samples.Num() == 0)
+	{
+		Samples.Add(Location);
+		SampleLengths.Add(0.0);
+		NumSamples++;
+		return;
+	}
+
+	const double Distance = FVector2D::Distance(Samples.Last(), Location);
+	if (Distance < MinSampleDistance)
+	{
+		return;
+	}
+
+	Samples.Add(Location);
+	SampleLengths.Add(SampleLengths.Last() + Distance);
+	NumSamples++;
+
+	FCubic Cubic;
+	if (Samples.Num() <= MaxSamplesPerSegment && FitOpenSamples(Cubic) <= MaxErrorSquared)
+	{
+		OpenCubic = Cubic;
+		bHasOpenCubic = true;
+		return;
+	}
+
+	// The new sample no longer fits with the others, so the last good fit is closed and a new segment starts where it ends
+	const FVector2D SegmentEnd = Samples[Samples.Num() - 2];
+	CommitSegment(OpenCubic);
+
+	Samples.Reset();
+	SampleLengths.Reset();
+	Samples.Add(SegmentEnd);
+	Samples.Add(Location);
+	SampleLengths.Add(0.0);
+	SampleLengths.Add(FVector2D::Distance(SegmentEnd, Location));
+	FitOpenSamples(OpenCubic);
+	bHasOpenCubic = true;
+}
+
+void FSplineStrokeFitter::Finish()
+{
+	if (!bHasOpenCubic)
+	{
+		return;
+	}
+
+	CommitSegment(OpenCubic);
+
+	const FVector2D SegmentEnd = Samples.Last();
+	Samples.Reset();
+	SampleLengths.Reset();
+	Samples.Add(SegmentEnd);
+	SampleLengths.Add(0.0);
+}
+
+void FSplineStrokeFitter::GetPoints(TArray<FSlateSplinePoint>& OutPoints) const
+{
+	OutPoints = Points;
+	if (bHasOpenCubic)
+	{
+		if (OutPoints.Num() == 0)
+		{
+			OutPoints.Emplace(OpenCubic.P0, (OpenCubic.P1 - OpenCubic.P0) * BezierControlPointScale);
+		}
+		OutPoints.Emplace(OpenCubic.P3, (OpenCubic.P3 - OpenCubic.P2) * BezierControlPointScale);
+	}
+}
+
+FVector2D FSplineStrokeFitter::FCubic::Evaluate(double T) const
+{
+	const double OneMinusT = 1.0 - T;
+	return P0 * (OneMinusT * OneMinusT * OneMinusT)
+		+ P1 * (3.0 * OneMinusT * OneMinusT * T)
+		+ P2 * (3.0 * OneMinusT * T * T)
+		+ P3 * (T * T * T);
+}
+
+double FSplineStrokeFitter::FitOpenSamples(FCubic& OutCubic)
+{
+	// Chord length parameterization, refined below when the fit is close
+	const double TotalLength = SampleLengths.Last();
+	Params.SetNumUninitialized(Samples.Num());
+	for (int32 i = 0; i < Samples.Num(); i++)
+	{
+		Params[i] = TotalLength > 0.0 ? SampleLengths[i] / TotalLength : 0.0;
+	}
+
+	double ErrorSquared = 0.0;
+	for (int32 Iteration = 0; Iteration <= MaxReparameterizations; Iteration++)
+	{
+		GenerateCubic(OutCubic);
+		ErrorSquared = ComputeMaxErrorSquared(OutCubic);
+
+		// A fit far off will not converge by moving the parameters, the segment has to be split instead
+		if (ErrorSquared <= MaxErrorSquared || ErrorSquared > MaxErrorSquared * 16.0)
+		{
+			break;
+		}
+		Reparameterize(OutCubic);
+	}
+
+	return ErrorSquared;
+}
+
+void FSplineStrokeFitter::GenerateCubic(FCubic& OutCubic) const
+{
+	const int32 NumOpenSamples = Samples.Num();
+	const FVector2D& P0 = Samples[0];
+	const FVector2D& P3 = Samples.Last();
+	const double SegmentLength = FVector2D::Distance(P0, P3);
+
+	const FVector2D StartTangent = bHasStartHandle ? StartHandle.GetSafeNormal() : (Samples[FMath::Min(TangentSampleOffset, NumOpenSamples - 1)] - P0).GetSafeNormal();
+	const FVector2D EndTangent = (Samples[FMath::Max(NumOpenSamples - 1 - TangentSampleOffset, 0)] - P3).GetSafeNormal();
+
+	// Least squares for the distances of the inner control points along the end tangents, Schneider's method
+	double C00 = 0.0, C01 = 0.0, C11 = 0.0, X0 = 0.0, X1 = 0.0;
+	for (int32 i = 0; i < NumOpenSamples; i++)
+	{
+		const double T = Params[i];
+		const double OneMinusT = 1.0 - T;
+		const double B0 = OneMinusT * OneMinusT * OneMinusT;
+		const double B1 = 3.0 * OneMinusT * OneMinusT * T;
+		const double B2 = 3.0 * OneMinusT * T * T;
+		const double B3 = T * T * T;
+
+		const FVector2D A0 = StartTangent * B1;
+		const FVector2D A1 = EndTangent * B2;
+		FVector2D Residual = Samples[i] - (P0 * (B0 + B1) + P3 * (B2 + B3));
+		if (bHasStartHandle)
+		{
+			Residual -= StartHandle * B1;
+		}
+
+		C00 += A0 | A0;
+		C01 += A0 | A1;
+		C11 += A1 | A1;
+		X0 += A0 | Residual;
+		X1 += A1 | Residual;
+	}
+
+	// The start of a segment continuing the stroke is fixed by the end of the previous one, so only the end is solved for
+	const double Epsilon = UE_KINDA_SMALL_NUMBER * SegmentLength;
+	double StartAlpha = 0.0;
+	double EndAlpha = 0.0;
+	if (bHasStartHandle)
+	{
+		EndAlpha = C11 > UE_SMALL_NUMBER ? X1 / C11 : 0.0;
+	}
+	else
+	{
+		const double Determinant = C00 * C11 - C01 * C01;
+		if (FMath::Abs(Determinant) > UE_SMALL_NUMBER)
+		{
+			StartAlpha = (X0 * C11 - X1 * C01) / Determinant;
+			EndAlpha = (C00 * X1 - C01 * X0) / Determinant;
+		}
+	}
+
+	// Degenerate or backwards solutions fall back to the Wu-Barsky heuristic
+	if (!bHasStartHandle && StartAlpha < Epsilon)
+	{
+		StartAlpha = SegmentLength / BezierControlPointScale;
+	}
+	if (EndAlpha < Epsilon)
+	{
+		EndAlpha = SegmentLength / BezierControlPointScale;
+	}
+
+	OutCubic.P0 = P0;
+	OutCubic.P1 = bHasStartHandle ? P0 + StartHandle : P0 + StartTangent * StartAlpha;
+	OutCubic.P2 = P3 + EndTangent * EndAlpha;
+	OutCubic.P3 = P3;
+}
+
+double FSplineStrokeFitter::ComputeMaxErrorSquared(const FCubic& Cubic) const
+{
+	double MaxError = 0.0;
+	for (int32 i = 1; i < Samples.Num() - 1; i++)
+	{
+		MaxError = FMath::Max(MaxError, FVector2D::DistSquared(Cubic.Evaluate(Params[i]), Samples[i]));
+	}
+	return MaxError;
+}
+
+void FSplineStrokeFitter::Reparameterize(const FCubic& Cubic)
+{
+	// One Newton-Raphson step towards the closest point of the cubic to each sample
+	for (int32 i = 1; i < Samples.Num() - 1; i++)
+	{
+		const double T = Params[i];
+		const double OneMinusT = 1.0 - T;
+		const FVector2D Difference = Cubic.Evaluate(T) - Samples[i];
+		const FVector2D FirstDerivative = (Cubic.P1 - Cubic.P0) * (3.0 * OneMinusT * OneMinusT)
+			+ (Cubic.P2 - Cubic.P1) * (6.0 * OneMinusT * T)
+			+ (Cubic.P3 - Cubic.P2) * (3.0 * T * T);
+		const FVector2D SecondDerivative = (Cubic.P2 - Cubic.P1 * 2.0 + Cubic.P0) * (6.0 * OneMinusT)
+			+ (Cubic.P3 - Cubic.P2 * 2.0 + Cubic.P1) * (6.0 * T);
+
+		const double Numerator = Difference | FirstDerivative;
+		const double Denominator = (FirstDerivative | FirstDerivative) + (Difference | SecondDerivative);
+		if (FMath::Abs(Denominator) > UE_SMALL_NUMBER)
+		{
+			Params[i] = FMath::Clamp(T - Numerator / Denominator, 0.0, 1.0);
+		}
+	}
+}
+
+void FSplineStrokeFitter::CommitSegment(const FCubic& Cubic)
+{
+	if (Points.Num() == 0)
+	{
+		Points.Emplace(Cubic.P0, (Cubic.P1 - Cubic.P0) * BezierControlPointScale);
+	}
+	Points.Emplace(Cubic.P3, (Cubic.P3 - Cubic.P2) * BezierControlPointScale);
+
+	// A spline point has a single direction, so the next segment has to leave with the same handle this one arrives with
+	StartHandle = Cubic.P3 - Cubic.P2;
+	bHasStartHandle = true;
+	bHasOpenCubic = false;
+}
@@ -3,22 +3,200 @@
 #include "Slate/SSpline.h"
 
 #include "Data/SlatePaintContext.h"
-#include "Slate/SplineBuilder.h"
+#include "Slate/SplineGeometryRegistry.h"
+#include "Slate/SplineTessellation.h"
 
 void SSpline::Construct(const FArguments& InArguments)
 {
 	Spline = InArguments._Spline;
+	OnGetSpline = InArguments._OnGetSpline;
+	SplineVersion = InArguments._SplineVersion;
+	OnGetSplineCurves = InArguments._OnGetSplineCurves;
+	UVOffset = InArguments._UVOffset;
+	UVScrollSpeed = InArguments._UVScrollSpeed;
+	FillColor = InArguments._FillColor;
+	bDrawPolylineWhileBuilding = InArguments._bDrawPolylineWhileBuilding;
+	bHitTestStroke = InArguments._bHitTestStroke;
+	HitTolerance = InArguments._HitTolerance;
+	OnClicked = InArguments._OnClicked;
+	OnHovered = InArguments._OnHovered;
+	OnUnhovered = InArguments._OnUnhovered;
+}
+
+void SSpline::SetUVScroll(float InUVOffset, float InUVScrollSpeed)
+{
+	if (UVOffset != InUVOffset || UVScrollSpeed != InUVScrollSpeed)
+	{
+		UVOffset = InUVOffset;
+		UVScrollSpeed = InUVScrollSpeed;
+		Invalidate(EInvalidateWidgetReason::Paint | EInvalidateWidgetReason::Volatility);
+	}
+}
+
+void SSpline::SetFillColor(const FLinearColor& InFillColor)
+{
+	if (FillColor != InFillColor)
+	{
+		FillColor = InFillColor;
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+void SSpline::SetHitTestStroke(bool bInHitTestStroke, float InHitTolerance)
+{
+	bHitTestStroke = bInHitTestStroke;
+	HitTolerance = InHitTolerance;
+	if (!bHitTestStroke && bIsStrokeHovered)
+	{
+		bIsStrokeHovered = false;
+		OnUnhovered.ExecuteIfBound();
+	}
+}
+
+bool SSpline::HitTestStroke(const FVector2D& LocalPosition, FSplineHitResult& OutHit) const
+{
+	const FSlateSpline& SplineRef = GetSpline();
+	if (SplineRef.Points.Num() < 2)
+	{
+		return false;
+	}
+
+	const TOptional<uint32> Version = SplineVersion.IsSet() ? TOptional<uint32>(SplineVersion.Get()) : TOptional<uint32>();
+	if (!HitTester.IsBuiltFor(Version, SplineRef.Brush.GetImageSize().X))
+	{
+		// Without a curves delegate, splines already drawn elsewhere share their curves through the registry
+		TSharedPtr<const FSlateSplineCurves> RegistryCurves;
+		const FSlateSplineCurves* Curves = nullptr;
+		if (OnGetSplineCurves.IsBound())
+		{
+			Curves = OnGetSplineCurves.Execute();
+		}
+		else
+		{
+			RegistryCurves = FSplineGeometryRegistry::Get().FindOrAddCurves(SplineRef);
+			Curves = RegistryCurves.Get();
+		}
+
+		if (!Curves)
+		{
+			return false;
+		}
+		HitTester.Build(*Curves, SplineRef, Version);
+	}
+
+	return HitTester.HitTest(LocalPosition, HitTolerance, OutHit);
+}
+
+FReply SSpline::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	FSplineHitResult Hit;
+	if (bHitTestStroke && MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton
+		&& HitTestStroke(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()), Hit))
+	{
+		bIsStrokePressed = true;
+		return FReply::Handled().CaptureMouse(SharedThis(this));
+	}
+
+	// Presses beside the stroke are left to the widgets below
+	return SLeafWidget::OnMouseButtonDown(MyGeometry, MouseEvent);
+}
+
+FReply SSpline::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!bIsStrokePressed || MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton)
+	{
+		return SLeafWidget::OnMouseButtonUp(MyGeometry, MouseEvent);
+	}
+
+	// Like a button, the click only counts if it is released over the stroke it was pressed on
+	bIsStrokePressed = false;
+	FSplineHitResult Hit;
+	if (bHitTestStroke && HitTestStroke(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()), Hit))
+	{
+		OnClicked.ExecuteIfBound(Hit);
+	}
+	return FReply::Handled().ReleaseMouseCapture();
+}
+
+FReply SSpline::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!bHitTestStroke)
+	{
+		return SLeafWidget::OnMouseMove(MyGeometry, MouseEvent);
+	}
+
+	FSplineHitResult Hit;
+	const bool bIsHit = HitTestStroke(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()), Hit);
+	if (bIsHit != bIsStrokeHovered)
+	{
+		bIsStrokeHovered = bIsHit;
+		if (bIsHit)
+		{
+			OnHovered.ExecuteIfBound(Hit);
+		}
+		else
+		{
+			OnUnhovered.ExecuteIfBound();
+		}
+	}
+
+	// Moves are not consumed, so widgets below keep tracking the mouse
+	return FReply::Unhandled();
+}
+
+void SSpline::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+
+	if (bIsStrokeHovered)
+	{
+		bIsStrokeHovered = false;
+		OnUnhovered.ExecuteIfBound();
+	}
+}
+
+void SSpline::OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent)
+{
+	SLeafWidget::OnMouseCaptureLost(CaptureLostEvent);
+	bIsStrokePressed = false;
+}
+
+bool SSpline::ComputeVolatility() const
+{
+	// A scrolling brush has to be repainted every frame
+	return SLeafWidget::ComputeVolatility() || UVScrollSpeed != 0.0f;
+}
+
+const FSlateSpline& SSpline::GetSpline() const
+{
+	if (OnGetSpline.IsBound())
+	{
+		if (const FSlateSpline* SplinePtr = OnGetSpline.Execute())
+		{
+			return *SplinePtr;
+		}
+	}
+	return Spline.Get();
 }
 
 FVector2D SSpline::ComputeDesiredSize(float LayoutScaleMultiplier) const
 {
-	const FSlateSpline& SplineRef = Spline.Get();
+	const FSlateSpline& SplineRef = GetSpline();
 	if (SplineRef.Points.Num() == 0)
 	{
 		return FVector2D::ZeroVector;
 	}
 
 	FBox2D BoundingBox(FVector2D::ZeroVector, FVector2D::UnitVector);
+
+	// The bounds of the curves include where the curve overshoots its points
+	const FSlateSplineCurves* Curves = OnGetSplineCurves.IsBound() ? OnGetSplineCurves.Execute() : nullptr;
+	if (Curves && Curves->Bounds.bIsValid && Curves->Position.Points.Num() == SplineRef.Points.Num())
+	{
+		BoundingBox += Curves->Bounds;
+		return BoundingBox.GetSize();
+	}
+
 	for (const FSlateSplinePoint& SplinePoint : SplineRef.Points)
 	{
 		BoundingBox.Min.X = FMath::Min(BoundingBox.Min.X, SplinePoint.Location.X);
@@ -35,7 +213,7 @@ int32 SSpline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry
 	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
 	const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	const FSlateSpline& SplineRef = Spline.Get();
+	const FSlateSpline& SplineRef = GetSpline();
 	if (SplineRef.Points.Num() < 2)
 	{
 		return LayerId;
@@ -45,7 +223,7 @@ int32 SSpline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry
 		ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect,
 		SplineRef.Brush.TintColor.GetColor(InWidgetStyle).ToFColorSRGB());
 
-	if (SplineRef.Brush.GetResourceObject()->IsValidLowLevel())
+	if (BrushResource.Update(SplineRef.Brush))
 	{
 		PaintSplineBrush(PaintContext);
 	}
@@ -59,52 +237,73 @@ int32 SSpline::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry
 
 void SSpline::PaintSplineSimple(const FSlatePaintContext& InPaintContext) const
 {
-	const FSlateSpline& SplineRef = Spline.Get();
-	const auto& DrawSplineSegment = [&](const FSlateSplinePoint& SegmentStart, const FSlateSplinePoint& SegmentEnd){
-		const FVector2D& SegmentStartDirection = SplineRef.bIsLinear ? FVector2D::ZeroVector : SegmentStart.Direction;
-		const FVector2D& SegmentEndDirection = SplineRef.bIsLinear ? FVector2D::ZeroVector : SegmentEnd.Direction;
-		FSlateDrawElement::MakeSpline(
-				InPaintContext.OutDrawElements,
-				InPaintContext.LayerId,
-				InPaintContext.AllotedGeometry.ToPaintGeometry(),
-				SegmentStart.Location,
-				SegmentStartDirection,
-				SegmentEnd.Location,
-				SegmentEndDirection,
-				SplineRef.Brush.GetImageSize().X,
-				InPaintContext.DrawEffect,
-				InPaintContext.TintColor);
-	};
-	
-	for (int i = 0; i < SplineRef.Points.Num() - 1; i++)
+	const FSlateSpline& SplineRef = GetSpline();
+
+	// The built-in spline element only draws strokes, the fill comes from the cached geometry
+	const FColor SplineFillColor = FSplineTessellation::GetEffectiveFillColor(SplineRef, FillColor.ToFColorSRGB());
+	if (SplineFillColor.A > 0)
 	{
-		DrawSplineSegment(SplineRef.Points[i], SplineRef.Points[i + 1]);
+		Tessellation.Update(SplineRef, SplineVersion.IsSet() ? TOptional<uint32>(SplineVersion.Get()) : TOptional<uint32>(), InPaintContext.TintColor, SplineFillColor);
+		Tessellation.PaintFill(InPaintContext, InPaintContext.GetRenderTransform());
 	}
-	
-	if (SplineRef.bIsClosedLoop)
+
+	FSplineTessellation::PaintSimple(InPaintContext, SplineRef, InPaintContext.AllotedGeometry.ToPaintGeometry());
+}
+
+void SSpline::PaintSplineBrush(const FSlatePaintContext& InPaintContext) const
+{
+	const FSlateSpline& SplineRef = GetSpline();
+
+	// The tessellation owns the queued build, so the callback never outlives this widget
+	SSpline* MutableThis = const_cast<SSpline*>(this);
+	const bool bIsReady = Tessellation.UpdateDeferred(SplineRef, SplineVersion.IsSet() ? TOptional<uint32>(SplineVersion.Get()) : TOptional<uint32>(), InPaintContext.TintColor, FillColor.ToFColorSRGB(),
+		[MutableThis]() { MutableThis->Invalidate(EInvalidateWidgetReason::Paint); });
+	if (!bIsReady)
 	{
-		DrawSplineSegment(SplineRef.Points.Last(), SplineRef.Points[0]);
+		if (bDrawPolylineWhileBuilding)
+		{
+			PaintSplinePolyline(InPaintContext);
+		}
+		return;
 	}
+
+	Tessellation.PaintBrush(InPaintContext, BrushResource.GetHandle(), InPaintContext.GetRenderTransform(), GetUVOffsetAtTime(FSlateApplication::Get().GetCurrentTime()));
 }
 
-void SSpline::PaintSplineBrush(const FSlatePaintContext& InPaintContext) const
+void SSpline::PaintSplinePolyline(const FSlatePaintContext& InPaintContext) const
 {
-	const FSlateSpline& SplineRef = Spline.Get();
-	FSplineBuilder SplineBuilder(SplineRef.Brush.GetImageSize(), InPaintContext);
-	
-	for (int i = 0; i < SplineRef.Points.Num() - 1; i++)
+	const FSlateSpline& SplineRef = GetSpline();
+
+	TArray<FVector2D> LinePoints;
+	LinePoints.Reserve(SplineRef.Points.Num() + 1);
+	for (const FSlateSplinePoint& SplinePoint : SplineRef.Points)
 	{
-		SplineBuilder.BuildBezierGeometry(SplineRef.Points[i], SplineRef.Points[i + 1], SplineRef.bIsLinear);
+		LinePoints.Add(SplinePoint.Location);
 	}
-	
+
 	if (SplineRef.bIsClosedLoop)
 	{
-		SplineBuilder.BuildBezierGeometry(SplineRef.Points.Last(), SplineRef.Points[0], SplineRef.bIsLinear);
+		LinePoints.Add(SplineRef.Points[0].Location);
 	}
 
-	SplineBuilder.Finish(SplineRef.bIsClosedLoop);
-	
-	
-	const FSlateResourceHandle& RenderResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(SplineRef.Brush);
-	FSlateDrawElement::MakeCustomVerts(InPaintContext.OutDrawElements, InPaintContext.LayerId, RenderResourceHandle, SplineBuilder.GetVertexArray(), SplineBuilder.GetIndexArray(), nullptr, 0, 0, InPaintContext.DrawEffect);
+	FSlateDrawElement::MakeLines(
+		InPaintContext.OutDrawElements,
+		InPaintContext.LayerId,
+		InPaintContext.PaintGeometry,
+		LinePoints,
+		InPaintContext.DrawEffect,
+		InPaintContext.TintColor,
+		true,
+		SplineRef.Brush.GetImageSize().X);
+}
+
+float SSpline::GetUVOffsetAtTime(double InCurrentTime) const
+{
+	if (UVScrollSpeed == 0.0f)
+	{
+		return UVOffset;
+	}
+
+	// V wraps every unit, so only the fraction is kept to stay precise over long sessions
+	return UVOffset + FMath::Frac(UVScrollSpeed * InCurrentTime);
 }
@@ -0,0 +1,213 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SSplineRailPanel.h"
+
+#include "Layout/ArrangedChildren.h"
+
+void SSplineRailPanel::FSlot::Construct(const FChildren& SlotOwner, FSlotArguments&& InArgs)
+{
+	TSlotBase<FSlot>::Construct(SlotOwner, MoveTemp(InArgs));
+	Position = InArgs._Position.Get(Position);
+	bIsPositionNormalized = InArgs._bIsPositionNormalized.Get(bIsPositionNormalized);
+	Alignment = InArgs._Alignment.Get(Alignment);
+	bOrientToTangent = InArgs._bOrientToTangent.Get(bOrientToTangent);
+}
+
+void SSplineRailPanel::FSlot::SetPosition(float InPosition)
+{
+	if (Position != InPosition)
+	{
+		Position = InPosition;
+		InvalidatePlacement();
+	}
+}
+
+void SSplineRailPanel::FSlot::SetIsPositionNormalized(bool bInIsPositionNormalized)
+{
+	if (bIsPositionNormalized != bInIsPositionNormalized)
+	{
+		bIsPositionNormalized = bInIsPositionNormalized;
+		InvalidatePlacement();
+	}
+}
+
+void SSplineRailPanel::FSlot::SetAlignment(const FVector2D& InAlignment)
+{
+	if (Alignment != InAlignment)
+	{
+		Alignment = InAlignment;
+		if (SWidget* OwnerWidget = GetOwnerWidget())
+		{
+			OwnerWidget->Invalidate(EInvalidateWidgetReason::Layout);
+		}
+	}
+}
+
+void SSplineRailPanel::FSlot::SetOrientToTangent(bool bInOrientToTangent)
+{
+	if (bOrientToTangent != bInOrientToTangent)
+	{
+		bOrientToTangent = bInOrientToTangent;
+		if (SWidget* OwnerWidget = GetOwnerWidget())
+		{
+			OwnerWidget->Invalidate(EInvalidateWidgetReason::Layout);
+		}
+	}
+}
+
+void SSplineRailPanel::FSlot::InvalidatePlacement()
+{
+	bIsPlacementDirty = true;
+	if (SWidget* OwnerWidget = GetOwnerWidget())
+	{
+		OwnerWidget->Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+SSplineRailPanel::FSlot::FSlotArguments SSplineRailPanel::Slot()
+{
+	return FSlot::FSlotArguments(MakeUnique<FSlot>());
+}
+
+SSplineRailPanel::FScopedWidgetSlotArguments SSplineRailPanel::AddSlot()
+{
+	Invalidate(EInvalidateWidgetReason::Layout);
+	return FScopedWidgetSlotArguments{ MakeUnique<FSlot>(), Children, INDEX_NONE };
+}
+
+int32 SSplineRailPanel::RemoveSlot(const TSharedRef<SWidget>& SlotWidget)
+{
+	Invalidate(EInvalidateWidgetReason::Layout);
+	return Children.Remove(SlotWidget);
+}
+
+void SSplineRailPanel::ClearChildren()
+{
+	Invalidate(EInvalidateWidgetReason::Layout);
+	Children.Empty();
+}
+
+SSplineRailPanel::SSplineRailPanel()
+	: Children(this)
+{
+	SetCanTick(false);
+	bCanSupportFocus = false;
+}
+
+void SSplineRailPanel::Construct(const FArguments& InArgs)
+{
+	OnGetSplineCurves = InArgs._OnGetSplineCurves;
+	Children.AddSlots(MoveTemp(const_cast<TArray<FSlot::FSlotArguments>&>(InArgs._Slots)));
+}
+
+void SSplineRailPanel::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const
+{
+	UpdatePlacements();
+
+	for (int32 ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex)
+	{
+		const FSlot& CurChild = Children[ChildIndex];
+		const TSharedRef<SWidget>& Widget = CurChild.GetWidget();
+		const EVisibility ChildVisibility = Widget->GetVisibility();
+		if (!ArrangedChildren.Accepts(ChildVisibility))
+		{
+			continue;
+		}
+
+		// Only the alignment depends on the child's current size, the placement itself is cached
+		const FVector2D Size = Widget->GetDesiredSize();
+		const FVector2D Offset = CurChild.CachedLocation - Size * CurChild.Alignment;
+		const FSlateRenderTransform RenderTransform = CurChild.bOrientToTangent
+			? FSlateRenderTransform(FQuat2D(FMath::DegreesToRadians(CurChild.CachedRotationAngle)))
+			: FSlateRenderTransform();
+
+		ArrangedChildren.AddWidget(ChildVisibility, AllottedGeometry.MakeChild(Widget, Size, FSlateLayoutTransform(Offset), RenderTransform, CurChild.Alignment));
+	}
+}
+
+FVector2D SSplineRailPanel::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	UpdatePlacements();
+
+	FVector2D DesiredSize = FVector2D::ZeroVector;
+	for (int32 ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex)
+	{
+		const FSlot& CurChild = Children[ChildIndex];
+		const TSharedRef<SWidget>& Widget = CurChild.GetWidget();
+		if (Widget->GetVisibility() == EVisibility::Collapsed)
+		{
+			continue;
+		}
+
+		const FVector2D ChildMax = CurChild.CachedLocation + Widget->GetDesiredSize() * (FVector2D::UnitVector - CurChild.Alignment);
+		DesiredSize = FVector2D::Max(DesiredSize, ChildMax);
+	}
+
+	return DesiredSize;
+}
+
+FChildren* SSplineRailPanel::GetChildren()
+{
+	return &Children;
+}
+
+void SSplineRailPanel::UpdatePlacements() const
+{
+	const FSlateSplineCurves* Curves = OnGetSplineCurves.IsBound() ? OnGetSplineCurves.Execute() : nullptr;
+	if (!Curves)
+	{
+		return;
+	}
+
+	const bool bHasCurveChanged = !bHasCachedCurvesVersion || CachedCurvesVersion != Curves->Version;
+	CachedCurvesVersion = Curves->Version;
+	bHasCachedCurvesVersion = true;
+
+	const float SplineLength = Curves->GetSplineLength();
+	TArray<int32, TInlineAllocator<16>> DirtySlots;
+	TArray<float, TInlineAllocator<16>> Distances;
+	for (int32 ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex)
+	{
+		const FSlot& CurChild = Children[ChildIndex];
+		if (bHasCurveChanged || CurChild.bIsPlacementDirty)
+		{
+			DirtySlots.Add(ChildIndex);
+			Distances.Add(CurChild.bIsPositionNormalized ? CurChild.Position * SplineLength : CurChild.Position);
+		}
+	}
+
+	if (DirtySlots.Num() == 0)
+	{
+		return;
+	}
+
+	// Sorting the distances lets the curves resolve them all in a single walk along the spline
+	TArray<int32, TInlineAllocator<16>> Order;
+	Order.SetNumUninitialized(DirtySlots.Num());
+	for (int32 i = 0; i < Order.Num(); i++)
+	{
+		Order[i] = i;
+	}
+	Order.Sort([&Distances](const int32 A, const int32 B) { return Distances[A] < Distances[B]; });
+
+	TArray<float, TInlineAllocator<16>> SortedDistances;
+	SortedDistances.SetNumUninitialized(Order.Num());
+	for (int32 i = 0; i < Order.Num(); i++)
+	{
+		SortedDistances[i] = Distances[Order[i]];
+	}
+
+	TArray<FVector2D, TInlineAllocator<16>> Locations;
+	TArray<float, TInlineAllocator<16>> RotationAngles;
+	Locations.SetNumUninitialized(Order.Num());
+	RotationAngles.SetNumUninitialized(Order.Num());
+	Curves->GetLocationsAndRotationsAtDistances(SortedDistances, Locations, RotationAngles);
+
+	for (int32 i = 0; i < Order.Num(); i++)
+	{
+		const FSlot& CurChild = Children[DirtySlots[Order[i]]];
+		CurChild.CachedLocation = Locations[i];
+		CurChild.CachedRotationAngle = RotationAngles[i];
+		CurChild.bIsPlacementDirty = false;
+	}
+}
@@ -0,0 +1,197 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SSplineText.h"
+
+#include "Fonts/FontCache.h"
+#include "Framework/Application/SlateApplication.h"
+
+void SSplineText::Construct(const FArguments& InArguments)
+{
+	SSpline::Construct(SSpline::FArguments()
+		.Spline(InArguments._Spline)
+		.OnGetSpline(InArguments._OnGetSpline)
+		.SplineVersion(InArguments._SplineVersion)
+		.OnGetSplineCurves(InArguments._OnGetSplineCurves)
+		.bDrawPolylineWhileBuilding(InArguments._bDrawPolylineWhileBuilding)
+		.bHitTestStroke(InArguments._bHitTestStroke)
+		.HitTolerance(InArguments._HitTolerance)
+		.OnClicked(InArguments._OnClicked)
+		.OnHovered(InArguments._OnHovered)
+		.OnUnhovered(InArguments._OnUnhovered));
+
+	Text = InArguments._Text;
+	Font = InArguments._Font;
+	ColorAndOpacity = InArguments._ColorAndOpacity;
+	StartDistance = InArguments._StartDistance;
+	BaselineOffset = InArguments._BaselineOffset;
+	bDrawSpline = InArguments._bDrawSpline;
+}
+
+int32 SSplineText::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
+	const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	int32 OutLayerId = LayerId;
+	if (bDrawSpline)
+	{
+		OutLayerId = SSpline::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	}
+
+	const FSlateSplineCurves* Curves = OnGetSplineCurves.IsBound() ? OnGetSplineCurves.Execute() : nullptr;
+	if (!Curves || Text.IsEmpty())
+	{
+		return OutLayerId;
+	}
+
+	const float FontScale = AllottedGeometry.Scale;
+	UpdateGlyphPlacements(*Curves, FontScale);
+
+	const ESlateDrawEffect DrawEffect = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const FLinearColor Tint = ColorAndOpacity.GetColor(InWidgetStyle) * InWidgetStyle.GetColorAndOpacityTint();
+
+	// Glyphs are shaped at the geometry scale and drawn with its inverse, so they stay crisp.
+	// Every glyph goes on the same layer, so the element batcher merges them into a single text batch.
+	const float InverseScale = 1.0f / FontScale;
+	const float BaselinePivot = CachedLineHeight > 0.0f ? CachedBaseline / CachedLineHeight : 1.0f;
+	++OutLayerId;
+
+	for (const FGlyphPlacement& Glyph : CachedGlyphs)
+	{
+		if (!Glyph.Glyphs.IsValid())
+		{
+			continue;
+		}
+
+		const FVector2D GlyphSize(Glyph.Advance, CachedLineHeight);
+		const FVector2D Pivot(0.5f, BaselinePivot);
+		const FVector2D GlyphOffset = Glyph.Location - GlyphSize * Pivot * InverseScale;
+
+		FSlateDrawElement::MakeShapedText(
+			OutDrawElements,
+			OutLayerId,
+			AllottedGeometry.ToPaintGeometry(GlyphSize, FSlateLayoutTransform(InverseScale, GlyphOffset), FSlateRenderTransform(FQuat2D(FMath::DegreesToRadians(Glyph.RotationAngle))), Pivot),
+			Glyph.Glyphs.ToSharedRef(),
+			DrawEffect,
+			Tint,
+			Tint);
+	}
+
+	return OutLayerId;
+}
+
+void SSplineText::SetText(const FText& InText)
+{
+	Text = InText;
+	bAreGlyphsDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::SetFont(const FSlateFontInfo& InFont)
+{
+	Font = InFont;
+	bAreGlyphsDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::SetColorAndOpacity(const FSlateColor& InColorAndOpacity)
+{
+	ColorAndOpacity = InColorAndOpacity;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::SetStartDistance(float InStartDistance)
+{
+	StartDistance = InStartDistance;
+	bAreGlyphsDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::SetBaselineOffset(float InBaselineOffset)
+{
+	BaselineOffset = InBaselineOffset;
+	bAreGlyphsDirty = true;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::SetDrawSpline(bool bInDrawSpline)
+{
+	bDrawSpline = bInDrawSpline;
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void SSplineText::UpdateGlyphPlacements(const FSlateSplineCurves& Curves, float FontScale) const
+{
+	if (!bAreGlyphsDirty && CachedFontScale == FontScale && CachedCurvesVersion == Curves.Version)
+	{
+		return;
+	}
+
+	bAreGlyphsDirty = false;
+	CachedFontScale = FontScale;
+	CachedCurvesVersion = Curves.Version;
+	CachedGlyphs.Reset();
+
+	const TSharedRef<FSlateFontCache> FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+	const FShapedGlyphSequenceRef ShapedText = FontCache->ShapeBidirectionalText(Text.ToString(), Font, FontScale, TextBiDi::ETextDirection::LeftToRight, GetDefaultTextShapingMethod());
+	CachedLineHeight = ShapedText->GetMaxTextHeight();
+	CachedBaseline = CachedLineHeight + ShapedText->GetTextBaseline();
+
+	// Group the glyphs into clusters, each placed at the distance of its center along the spline
+	struct FGlyphCluster
+	{
+		int32 StartSourceIndex;
+		int32 EndSourceIndex;
+		float PenPosition;
+		bool bIsVisible;
+	};
+	TArray<FGlyphCluster> Clusters;
+	float PenPosition = 0.0f;
+	for (const FShapedGlyphEntry& GlyphEntry : ShapedText->GetGlyphsToRender())
+	{
+		if (GlyphEntry.NumCharactersInGlyph > 0 || Clusters.Num() == 0)
+		{
+			Clusters.Add({ GlyphEntry.SourceIndex, GlyphEntry.SourceIndex + GlyphEntry.NumCharactersInGlyph, PenPosition, false });
+			CachedGlyphs.AddDefaulted();
+		}
+
+		FGlyphCluster& Cluster = Clusters.Last();
+		Cluster.StartSourceIndex = FMath::Min(Cluster.StartSourceIndex, GlyphEntry.SourceIndex);
+		Cluster.EndSourceIndex = FMath::Max(Cluster.EndSourceIndex, GlyphEntry.SourceIndex + GlyphEntry.NumCharactersInGlyph);
+		Cluster.bIsVisible |= GlyphEntry.bIsVisible;
+		CachedGlyphs.Last().Advance += GlyphEntry.XAdvance;
+		PenPosition += GlyphEntry.XAdvance;
+	}
+
+	const float InverseScale = 1.0f / FontScale;
+	TArray<float> Distances;
+	Distances.SetNumUninitialized(Clusters.Num());
+	for (int32 i = 0; i < Clusters.Num(); i++)
+	{
+		Distances[i] = StartDistance + (Clusters[i].PenPosition + CachedGlyphs[i].Advance * 0.5f) * InverseScale;
+	}
+
+	TArray<FVector2D> Locations;
+	TArray<float> RotationAngles;
+	Locations.SetNumUninitialized(Clusters.Num());
+	RotationAngles.SetNumUninitialized(Clusters.Num());
+	Curves.GetLocationsAndRotationsAtDistances(Distances, Locations, RotationAngles);
+
+	const float SplineLength = Curves.GetSplineLength();
+	for (int32 i = 0; i < Clusters.Num(); i++)
+	{
+		FGlyphPlacement& Glyph = CachedGlyphs[i];
+		const FGlyphCluster& Cluster = Clusters[i];
+
+		// Glyphs that would run off either end of the spline are not drawn
+		if (!Cluster.bIsVisible || Distances[i] < 0.0f || Distances[i] > SplineLength)
+		{
+			continue;
+		}
+
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(RotationAngles[i]));
+		Glyph.Location = Locations[i] + FVector2D(-Sin, Cos) * BaselineOffset;
+		Glyph.RotationAngle = RotationAngles[i];
+		Glyph.Glyphs = ShapedText->GetSubSequence(Cluster.StartSourceIndex, Cluster.EndSourceIndex);
+	}
+}
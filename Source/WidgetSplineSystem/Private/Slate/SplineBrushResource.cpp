@@ -0,0 +1,66 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SplineBrushResource.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+
+FSplineBrushResourceCache& FSplineBrushResourceCache::Get()
+{
+	static FSplineBrushResourceCache Cache;
+	return Cache;
+}
+
+FSlateResourceHandle FSplineBrushResourceCache::FindOrAddHandle(const FSlateBrush& Brush)
+{
+	check(IsInGameThread());
+
+	UObject* BrushResourceObject = Brush.GetResourceObject();
+	if (!IsValid(BrushResourceObject))
+	{
+		return FSlateResourceHandle();
+	}
+
+	// Handles of released resources are resolved again, the renderer may have recreated them
+	FSlateResourceHandle& CachedHandle = Handles.FindOrAdd(FKey{BrushResourceObject, FVector2f(Brush.GetImageSize())});
+	if (CachedHandle.IsValid())
+	{
+		return CachedHandle;
+	}
+	CachedHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(Brush);
+	const FSlateResourceHandle Resolved = CachedHandle;
+
+	if (Handles.Num() > PurgeThreshold)
+	{
+		for (auto It = Handles.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResourceObject.ResolveObjectPtr() || !It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		PurgeThreshold = FMath::Max(64, Handles.Num() * 2);
+	}
+
+	return Resolved;
+}
+
+bool FSplineBrushResource::Update(const FSlateBrush& Brush)
+{
+	// Only the pointer and size are compared on every paint, the renderer is asked again when either or the resource changes
+	const UObject* BrushResourceObject = Brush.GetResourceObject();
+	const FVector2f BrushImageSize(Brush.GetImageSize());
+	const bool bIsSameResource = ResourceObject.Get() == BrushResourceObject && ImageSize == BrushImageSize
+		&& (bHasResource ? Handle.IsValid() : !IsValid(BrushResourceObject));
+	if (bIsValid && bIsSameResource)
+	{
+		return bHasResource;
+	}
+
+	ResourceObject = BrushResourceObject;
+	ImageSize = BrushImageSize;
+	bHasResource = IsValid(BrushResourceObject);
+	Handle = bHasResource ? FSplineBrushResourceCache::Get().FindOrAddHandle(Brush) : FSlateResourceHandle();
+	bIsValid = true;
+	return bHasResource;
+}
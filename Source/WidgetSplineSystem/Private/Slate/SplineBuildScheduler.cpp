@@ -0,0 +1,176 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SplineBuildScheduler.h"
+
+#include "Async/ParallelFor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Slate/SplineGeometryRegistry.h"
+
+static TAutoConsoleVariable<float> CVarSplineBuildBudgetMs(
+	TEXT("Slate.SplineBuildBudgetMs"),
+	2.0f,
+	TEXT("Milliseconds per frame spent on spline curves and brush geometry queued by spline widgets. 0 builds them right away."));
+
+void FSplineBuildRequest::Flush()
+{
+	if (Build.IsSet())
+	{
+		// The build may release this request, so it runs from a local copy
+		const TFunction<void()> LocalBuild = MoveTemp(Build);
+		Build.Reset();
+		LocalBuild();
+	}
+}
+
+FSplineBuildScheduler& FSplineBuildScheduler::Get()
+{
+	static FSplineBuildScheduler Scheduler;
+	return Scheduler;
+}
+
+TSharedRef<FSplineBuildRequest> FSplineBuildScheduler::Enqueue(TFunction<void()>&& Build)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FSplineBuildRequest> Request = MakeShared<FSplineBuildRequest>(MoveTemp(Build));
+	if (!IsTimeSliced())
+	{
+		Request->Flush();
+		return Request;
+	}
+
+	Queue.Add(Request);
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSplineBuildScheduler::Tick));
+	}
+	return Request;
+}
+
+TSharedRef<FSplineBuildRequest> FSplineBuildScheduler::EnqueueCurves(const FSlateSpline& Spline, TFunction<void()>&& Build)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FSplineBuildRequest> Request = MakeShared<FSplineBuildRequest>(MoveTemp(Build));
+	if (!IsTimeSliced() || !FSlateApplication::IsInitialized())
+	{
+		Request->Flush();
+		return Request;
+	}
+
+	if (!PreTickHandle.IsValid())
+	{
+		PreTickHandle = FSlateApplication::Get().OnPreTick().AddRaw(this, &FSplineBuildScheduler::BuildCurvesBatch);
+	}
+
+	FBatchedCurves& Batched = CurvesBatch.AddDefaulted_GetRef();
+	Batched.Request = Request;
+	Batched.Spline.Points = Spline.Points;
+	Batched.Spline.bIsLinear = Spline.bIsLinear;
+	Batched.Spline.bIsClosedLoop = Spline.bIsClosedLoop;
+	return Request;
+}
+
+bool FSplineBuildScheduler::IsTimeSliced() const
+{
+	return CVarSplineBuildBudgetMs.GetValueOnGameThread() > 0.0f;
+}
+
+int32 FSplineBuildScheduler::GetNumPending() const
+{
+	int32 NumPending = 0;
+	for (int32 i = QueueHead; i < Queue.Num(); i++)
+	{
+		const TSharedPtr<FSplineBuildRequest> Request = Queue[i].Pin();
+		NumPending += Request.IsValid() && Request->IsPending() ? 1 : 0;
+	}
+	return NumPending;
+}
+
+void FSplineBuildScheduler::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	// Slate may already be gone, taking the delegate with it
+	if (PreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPreTick().Remove(PreTickHandle);
+	}
+	PreTickHandle.Reset();
+
+	Queue.Reset();
+	QueueHead = 0;
+	CurvesBatch.Reset();
+}
+
+void FSplineBuildScheduler::BuildCurvesBatch(float DeltaTime)
+{
+	if (CurvesBatch.Num() == 0)
+	{
+		return;
+	}
+
+	// Builds cancelled, flushed or queued again since are left out
+	TArray<FBatchedCurves> Batch = MoveTemp(CurvesBatch);
+	CurvesBatch.Reset();
+	Batch.RemoveAllSwap([](const FBatchedCurves& Batched)
+	{
+		const TSharedPtr<FSplineBuildRequest> Request = Batched.Request.Pin();
+		return !Request.IsValid() || !Request->IsPending();
+	});
+
+	// Curves are pure functions of the points, so they are built in parallel. Holding them keeps their registry entries alive until published.
+	TArray<TSharedPtr<const FSlateSplineCurves>> BuiltCurves;
+	BuiltCurves.SetNum(Batch.Num());
+	ParallelFor(Batch.Num(), [&Batch, &BuiltCurves](int32 Index)
+	{
+		BuiltCurves[Index] = FSplineGeometryRegistry::Get().FindOrAddCurves(Batch[Index].Spline);
+	});
+
+	// Published on the game thread, each build finding its curves in the registry
+	for (const FBatchedCurves& Batched : Batch)
+	{
+		if (const TSharedPtr<FSplineBuildRequest> Request = Batched.Request.Pin())
+		{
+			Request->Flush();
+		}
+	}
+}
+
+bool FSplineBuildScheduler::Tick(float DeltaTime)
+{
+	const double EndTime = FPlatformTime::Seconds() + CVarSplineBuildBudgetMs.GetValueOnGameThread() / 1000.0;
+
+	// At least one build runs every frame, so the queue drains even if a single build exceeds the budget
+	bool bHasBuilt = false;
+	while (QueueHead < Queue.Num() && (!bHasBuilt || FPlatformTime::Seconds() < EndTime))
+	{
+		const TSharedPtr<FSplineBuildRequest> Request = Queue[QueueHead++].Pin();
+		if (Request.IsValid() && Request->IsPending())
+		{
+			Request->Flush();
+			bHasBuilt = true;
+		}
+	}
+
+	if (QueueHead == Queue.Num())
+	{
+		Queue.Reset();
+		QueueHead = 0;
+		TickerHandle.Reset();
+		return false;
+	}
+
+	// Drop the builds already run once they make up most of the queue
+	if (QueueHead > Queue.Num() / 2)
+	{
+		Queue.RemoveAt(0, QueueHead, false);
+		QueueHead = 0;
+	}
+	return true;
+}
@@ -2,14 +2,81 @@
 
 #include "Slate/SplineBuilder.h"
 
+namespace SplineBuilder
+{
+	/** Edge of a polygon filled by the even-odd rule, from its top to its bottom point. */
+	struct FFillEdge
+	{
+		FVector2D Top;
+		FVector2D Bottom;
+
+		double GetXAt(double Y) const
+		{
+			return FMath::Lerp(Top.X, Bottom.X, (Y - Top.Y) / (Bottom.Y - Top.Y));
+		}
+	};
+
+	/** Fills the band between two heights with a trapezoid between every odd crossing edge and the next one. */
+	static void FillBand(TConstArrayView<const FFillEdge*> Edges, double Top, double Bottom, int32 Depth, TArray<FVector2D>& OutPoints, TArray<int32>& OutIndices)
+	{
+		struct FCrossing
+		{
+			double TopX;
+			double BottomX;
+		};
+
+		TArray<FCrossing, TInlineAllocator<16>> Crossings;
+		for (const FFillEdge* Edge : Edges)
+		{
+			Crossings.Add({Edge->GetXAt(Top), Edge->GetXAt(Bottom)});
+		}
+		Crossings.Sort([](const FCrossing& A, const FCrossing& B) { return A.TopX + A.BottomX < B.TopX + B.BottomX; });
+
+		// Edges crossing each other inside the band swap order between its top and bottom, the band is split where they cross
+		constexpr int32 MaxDepth = 32;
+		for (int32 i = 0; i + 1 < Crossings.Num() && Depth < MaxDepth; i++)
+		{
+			const double TopGap = Crossings[i + 1].TopX - Crossings[i].TopX;
+			const double BottomGap = Crossings[i + 1].BottomX - Crossings[i].BottomX;
+			if ((TopGap < 0.0) != (BottomGap < 0.0) && FMath::Abs(TopGap - BottomGap) > UE_DOUBLE_SMALL_NUMBER)
+			{
+				const double SplitY = FMath::Lerp(Top, Bottom, TopGap / (TopGap - BottomGap));
+				if (SplitY > Top + UE_DOUBLE_KINDA_SMALL_NUMBER && SplitY < Bottom - UE_DOUBLE_KINDA_SMALL_NUMBER)
+				{
+					FillBand(Edges, Top, SplitY, Depth + 1, OutPoints, OutIndices);
+					FillBand(Edges, SplitY, Bottom, Depth + 1, OutPoints, OutIndices);
+					return;
+				}
+			}
+		}
+
+		for (int32 i = 0; i + 1 < Crossings.Num(); i += 2)
+		{
+			const int32 FirstIndex = OutPoints.Num();
+			OutPoints.Emplace(Crossings[i].TopX, Top);
+			OutPoints.Emplace(Crossings[i + 1].TopX, Top);
+			OutPoints.Emplace(Crossings[i + 1].BottomX, Bottom);
+			OutPoints.Emplace(Crossings[i].BottomX, Bottom);
+			OutIndices.Append({FirstIndex, FirstIndex + 1, FirstIndex + 2, FirstIndex, FirstIndex + 2, FirstIndex + 3});
+		}
+	}
+}
+
 FSplineBuilder::FSplineBuilder(const FVector2D& InSize, const FSlatePaintContext& PaintContext)
-	: RenderTransform(PaintContext.GetRenderTransform())
-	, SingleColor(PaintContext.TintColor)
+	: FSplineBuilder(InSize, PaintContext.GetRenderTransform(), PaintContext.TintColor)
+{
+}
+
+FSplineBuilder::FSplineBuilder(const FVector2D& InSize, const FSlateRenderTransform& InRenderTransform, const FColor InTintColor)
+	: RenderTransform(InRenderTransform)
+	, SingleColor(InTintColor)
+	, LinearTintColor(InTintColor)
 	, TextureCoord2(InSize.X, 1.0f)
 	, CoordScaleV(InSize.Y * 0.01f)
 {
-	const float LineThickness = 2 * UE_SQRT_2 + TextureCoord2.X;
-	HalfLineThickness = LineThickness / 2 + TextureCoord2.Y;
+	// Same as a line thickness of (2 * UE_SQRT_2 + TextureCoord2.X), split so the brush width can be scaled per point
+	HalfBaseThickness = UE_SQRT_2 + TextureCoord2.Y;
+	HalfBrushWidth = TextureCoord2.X / 2;
 }
 
 void FSplineBuilder::BuildBezierGeometry(FSlateSplinePoint SegmentStart, FSlateSplinePoint SegmentEnd, const bool bIsLinear)
@@ -25,7 +92,41 @@ void FSplineBuilder::BuildBezierGeometry(FSlateSplinePoint SegmentStart, FSlateS
 	const FVector2D P1 = SegmentStart.Location + SegmentStart.Direction / BezierControlPointScale;
 	const FVector2D P2 = SegmentEnd.Location - SegmentEnd.Direction / BezierControlPointScale;
 		
+	SegmentPoints.Reset();
+	SegmentPoints.Add(SegmentStart.Location);
 	Subdivide(SegmentStart.Location, P1, P2, SegmentEnd.Location, 1.0f);
+
+	float SegmentLength = 0.0f;
+	for (int32 i = 1; i < SegmentPoints.Num(); i++)
+	{
+		SegmentLength += FVector2D::Distance(SegmentPoints[i - 1], SegmentPoints[i]);
+	}
+	const float InvSegmentLength = SegmentLength > UE_SMALL_NUMBER ? 1.0f / SegmentLength : 0.0f;
+
+	const float StartHalfThickness = GetHalfLineThickness(SegmentStart.Width);
+	const float EndHalfThickness = GetHalfLineThickness(SegmentEnd.Width);
+	const bool bIsUniformColor = SegmentStart.Color == SegmentEnd.Color;
+	const FColor StartColor = GetPointColor(SegmentStart.Color);
+
+	// Width and color are interpolated by the length travelled along the flattened segment, so they
+	// change evenly even where the subdivision is dense. The segment start was already added as the
+	// end of the previous segment, except for the very first one.
+	float TravelledLength = 0.0f;
+	for (int32 i = 0; i < SegmentPoints.Num(); i++)
+	{
+		if (i > 0)
+		{
+			TravelledLength += FVector2D::Distance(SegmentPoints[i - 1], SegmentPoints[i]);
+		}
+		else if (NumPointsAdded > 0)
+		{
+			continue;
+		}
+
+		const float Alpha = TravelledLength * InvSegmentLength;
+		const FColor Color = bIsUniformColor ? StartColor : GetPointColor(FMath::Lerp(SegmentStart.Color, SegmentEnd.Color, Alpha));
+		AppendPoint(SegmentPoints[i], FMath::Lerp(StartHalfThickness, EndHalfThickness, Alpha), Color);
+	}
 }
 
 void FSplineBuilder::Finish(const bool bCloseLoop)
@@ -35,14 +136,14 @@ void FSplineBuilder::Finish(const bool bCloseLoop)
 		// Line builder needs at least two line segments (3 points) to
 		// complete building its geometry.
 		// This will only happen in the case when we have a straight line.
-		AppendPoint(LastPointAdded[0]);
+		AppendPoint(LastPointAdded[0], LastHalfThickness[0], LastColor[0]);
 	}
 	else
 	{
 		// We have added the last point, but the line builder only builds
 		// geometry for the previous line segment. Build geometry for the
 		// last line segment.
-		const FVector2D LastUp = LastNormal * HalfLineThickness;
+		const FVector2D LastUp = LastNormal * LastHalfThickness[0];
 
 		CurrentLength += FVector2D::Distance(LastPointAdded[1], LastPointAdded[0]);
 		CurrentCoordV = CurrentLength * CoordScaleV;
@@ -50,13 +151,13 @@ void FSplineBuilder::Finish(const bool bCloseLoop)
 		if (bCloseLoop)
 		{
 			const FSlateRenderTransform& TempRenderTransform = FSlateRenderTransform(1.0f);
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(TempRenderTransform, Vertices[0].Position, FVector2f(1.0f, CurrentCoordV), TextureCoord2, SingleColor));
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(TempRenderTransform, Vertices[1].Position, FVector2f(0.0f, CurrentCoordV), TextureCoord2, SingleColor));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(TempRenderTransform, Vertices[0].Position, FVector2f(1.0f, CurrentCoordV), TextureCoord2, Vertices[0].Color));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(TempRenderTransform, Vertices[1].Position, FVector2f(0.0f, CurrentCoordV), TextureCoord2, Vertices[1].Color));
 		}
 		else
 		{
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] + LastUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, SingleColor));
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] - LastUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, SingleColor));	
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] + LastUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, LastColor[0]));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] - LastUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, LastColor[0]));	
 		}
 
 		const int32 NumVerts = Vertices.Num();
@@ -72,11 +173,15 @@ void FSplineBuilder::Finish(const bool bCloseLoop)
 	}
 }
 
-void FSplineBuilder::AppendPoint(const FVector2D NewPoint)
+void FSplineBuilder::AppendPoint(const FVector2D NewPoint, const float NewHalfThickness, const FColor NewColor)
 	{
+		OutlinePoints.Add(NewPoint);
+
 		if (NumPointsAdded == 0)
 		{
 			LastPointAdded[0] = LastPointAdded[1] = NewPoint;
+			LastHalfThickness[0] = LastHalfThickness[1] = NewHalfThickness;
+			LastColor[0] = LastColor[1] = NewColor;
 			NumPointsAdded++;
 			return;
 		}
@@ -91,21 +196,21 @@ void FSplineBuilder::AppendPoint(const FVector2D NewPoint)
 		if (NumPointsAdded == 2)
 		{
 			// Once we have two points, we have a normal, so we can generate the first bit of geometry.
-			const FVector2D LastUp = LastNormal*HalfLineThickness;
+			const FVector2D LastUp = LastNormal*LastHalfThickness[1];
 
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[1] + LastUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, SingleColor));
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[1] - LastUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, SingleColor));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[1] + LastUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, LastColor[1]));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[1] - LastUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, LastColor[1]));
 		}
 
 		if (NumPointsAdded >= 2)
 		{
-			const FVector2D AveragedUp = (0.5f*(NewNormal + LastNormal)).GetSafeNormal()*HalfLineThickness;
+			const FVector2D AveragedUp = (0.5f*(NewNormal + LastNormal)).GetSafeNormal()*LastHalfThickness[0];
 
 			CurrentLength += FVector2D::Distance(LastPointAdded[1], LastPointAdded[0]);
 			CurrentCoordV = CurrentLength * CoordScaleV;
 
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] + AveragedUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, SingleColor));
-			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] - AveragedUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, SingleColor));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] + AveragedUp), FVector2f(1.0f, CurrentCoordV), TextureCoord2, LastColor[0]));
+			Vertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(LastPointAdded[0] - AveragedUp), FVector2f(0.0f, CurrentCoordV), TextureCoord2, LastColor[0]));
 
 			const int32 NumVerts = Vertices.Num();
 
@@ -121,11 +226,204 @@ void FSplineBuilder::AppendPoint(const FVector2D NewPoint)
 
 		LastPointAdded[1] = LastPointAdded[0];
 		LastPointAdded[0] = NewPoint;
+		LastHalfThickness[1] = LastHalfThickness[0];
+		LastHalfThickness[0] = NewHalfThickness;
+		LastColor[1] = LastColor[0];
+		LastColor[0] = NewColor;
 		LastNormal = NewNormal;
 
 		++NumPointsAdded;
 	}
 
+void FSplineBuilder::BuildFill(const FColor FillColor)
+{
+	// A closed loop ends where it started
+	TArray<FVector2D> Outline = OutlinePoints;
+	if (Outline.Num() > 1 && Outline.Last().Equals(Outline[0]))
+	{
+		Outline.Pop(false);
+	}
+	if (Outline.Num() < 3)
+	{
+		return;
+	}
+
+	TArray<int32> Triangles;
+	if (!TriangulatePolygon(Outline, Triangles))
+	{
+		TArray<FVector2D> Trapezoids;
+		if (!TriangulateEvenOdd(Outline, Trapezoids, Triangles))
+		{
+			return;
+		}
+		Outline = MoveTemp(Trapezoids);
+	}
+
+	// The fill samples the middle of the brush, where the stroke starts
+	TArray<FSlateVertex> FillVertices;
+	FillVertices.Reserve(Outline.Num());
+	for (const FVector2D& Point : Outline)
+	{
+		FillVertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(Point), FVector2f(0.5f, 0.0f), TextureCoord2, FillColor));
+	}
+
+	TArray<SlateIndex> FillIndices;
+	FillIndices.Reserve(Triangles.Num());
+	for (const int32 Index : Triangles)
+	{
+		FillIndices.Add(static_cast<SlateIndex>(Index));
+	}
+
+	for (SlateIndex& Index : Indices)
+	{
+		Index += FillVertices.Num();
+	}
+	Vertices.Insert(FillVertices, 0);
+	Indices.Insert(FillIndices, 0);
+	NumFillVertices = FillVertices.Num();
+	NumFillIndices = FillIndices.Num();
+}
+
+bool FSplineBuilder::TriangulatePolygon(TConstArrayView<FVector2D> Polygon, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	const int32 NumPoints = Polygon.Num();
+	if (NumPoints < 3)
+	{
+		return false;
+	}
+
+	// Clipped counterclockwise, so convex corners turn left
+	double TwiceArea = 0.0;
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		TwiceArea += FVector2D::CrossProduct(Polygon[i], Polygon[(i + 1) % NumPoints]);
+	}
+
+	TArray<int32> Remaining;
+	Remaining.SetNumUninitialized(NumPoints);
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		Remaining[i] = TwiceArea >= 0.0 ? i : NumPoints - 1 - i;
+	}
+	OutIndices.Reserve((NumPoints - 2) * 3);
+
+	const auto& IsInsideTriangle = [](const FVector2D& Point, const FVector2D& A, const FVector2D& B, const FVector2D& C)
+	{
+		return FVector2D::CrossProduct(B - A, Point - A) >= 0.0 && FVector2D::CrossProduct(C - B, Point - B) >= 0.0 && FVector2D::CrossProduct(A - C, Point - C) >= 0.0;
+	};
+
+	int32 Current = 0;
+	int32 NumVisitedWithoutEar = 0;
+	while (Remaining.Num() > 3)
+	{
+		if (NumVisitedWithoutEar > Remaining.Num())
+		{
+			return false;
+		}
+
+		const int32 NumRemaining = Remaining.Num();
+		const int32 Previous = Remaining[(Current + NumRemaining - 1) % NumRemaining];
+		const int32 Next = Remaining[(Current + 1) % NumRemaining];
+		const FVector2D& A = Polygon[Previous];
+		const FVector2D& B = Polygon[Remaining[Current]];
+		const FVector2D& C = Polygon[Next];
+		const double Turn = FVector2D::CrossProduct(B - A, C - B);
+
+		// Points on a straight line add no area, they are dropped without a triangle
+		bool bIsEar = FMath::Abs(Turn) <= UE_DOUBLE_SMALL_NUMBER;
+		if (!bIsEar && Turn > 0.0)
+		{
+			bIsEar = true;
+			for (int32 Other = 0; Other < NumRemaining && bIsEar; Other++)
+			{
+				const int32 OtherIndex = Remaining[Other];
+				bIsEar = OtherIndex == Previous || OtherIndex == Remaining[Current] || OtherIndex == Next || !IsInsideTriangle(Polygon[OtherIndex], A, B, C);
+			}
+
+			if (bIsEar)
+			{
+				OutIndices.Add(Previous);
+				OutIndices.Add(Remaining[Current]);
+				OutIndices.Add(Next);
+			}
+		}
+
+		if (bIsEar)
+		{
+			Remaining.RemoveAt(Current, 1, false);
+			Current = Current % Remaining.Num();
+			NumVisitedWithoutEar = 0;
+		}
+		else
+		{
+			Current = (Current + 1) % NumRemaining;
+			NumVisitedWithoutEar++;
+		}
+	}
+
+	OutIndices.Add(Remaining[0]);
+	OutIndices.Add(Remaining[1]);
+	OutIndices.Add(Remaining[2]);
+	return true;
+}
+
+bool FSplineBuilder::TriangulateEvenOdd(TConstArrayView<FVector2D> Polygon, TArray<FVector2D>& OutPoints, TArray<int32>& OutIndices)
+{
+	using namespace SplineBuilder;
+
+	OutPoints.Reset();
+	OutIndices.Reset();
+
+	// Horizontal edges bound no band, they only add the height of their points
+	TArray<FFillEdge> Edges;
+	TArray<double> Heights;
+	Edges.Reserve(Polygon.Num());
+	Heights.Reserve(Polygon.Num());
+	for (int32 i = 0; i < Polygon.Num(); i++)
+	{
+		const FVector2D& Start = Polygon[i];
+		const FVector2D& End = Polygon[(i + 1) % Polygon.Num()];
+		Heights.Add(Start.Y);
+		if (Start.Y != End.Y)
+		{
+			Edges.Add(Start.Y < End.Y ? FFillEdge{Start, End} : FFillEdge{End, Start});
+		}
+	}
+	if (Edges.Num() < 2)
+	{
+		return false;
+	}
+
+	Edges.Sort([](const FFillEdge& A, const FFillEdge& B) { return A.Top.Y < B.Top.Y; });
+	Heights.Sort();
+	int32 NumHeights = 0;
+	for (const double Height : Heights)
+	{
+		if (NumHeights == 0 || Heights[NumHeights - 1] != Height)
+		{
+			Heights[NumHeights++] = Height;
+		}
+	}
+
+	// Every band lies between two consecutive heights, so the edges crossing it span all of it
+	TArray<const FFillEdge*> ActiveEdges;
+	int32 NextEdge = 0;
+	for (int32 Band = 0; Band + 1 < NumHeights; Band++)
+	{
+		const double Top = Heights[Band];
+		while (NextEdge < Edges.Num() && Edges[NextEdge].Top.Y <= Top)
+		{
+			ActiveEdges.Add(&Edges[NextEdge++]);
+		}
+		ActiveEdges.RemoveAllSwap([Top](const FFillEdge* Edge) { return Edge->Bottom.Y <= Top; });
+
+		FillBand(ActiveEdges, Top, Heights[Band + 1], 0, OutPoints, OutIndices);
+	}
+
+	return OutIndices.Num() > 0;
+}
+
 float FSplineBuilder::ComputeCurviness(const FVector2D P0, const FVector2D P1, const FVector2D P2, const FVector2D P3)
 {
 	const FVector2D TwoP1Deviations = P0 + P2 - 2 * P1;
@@ -169,6 +467,6 @@ void FSplineBuilder::Subdivide(const FVector2D P0, const FVector2D P1, const FVe
 	}
 	else
 	{
-		AppendPoint(P3);
+		SegmentPoints.Add(P3);
 	}
 }
@@ -0,0 +1,242 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SplineGeometryRegistry.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+
+#include <atomic>
+
+namespace SplineGeometryRegistry
+{
+	/** Shared curves are never updated in place, so each entry gets its own version for the caches keyed by it. */
+	static std::atomic<uint32> NextCurvesVersion{0};
+
+	/** Curves are shared with the default parameters of FSlateSplineCurves::UpdateSpline. */
+	constexpr int32 ReparamStepsPerSegment = 10;
+
+	template<typename T>
+	static uint64 HashValue(const T& Value, uint64 Hash)
+	{
+		return CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(T), Hash);
+	}
+
+	static uint64 MakeSeed(int32 NumPoints, bool bIsLinear, bool bIsLooped)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(NumPoints)) << 2) | (bIsLinear ? 2 : 0) | (bIsLooped ? 1 : 0);
+	}
+
+	static bool IsLinear(const FSlateSpline& Spline)
+	{
+		return Spline.bIsLinear && Spline.Points.Num() > 0;
+	}
+
+	static bool IsLinear(const FSlateSplineCurves& Curves)
+	{
+		return Curves.Position.Points.Num() > 0 && Curves.Position.Points[0].InterpMode == CIM_Linear;
+	}
+
+	/** Only hashes what the curves keep of the spline, so curves loaded with a widget get the same key as the spline they were built from. */
+	static uint64 GetCurvesKey(const FSlateSpline& Spline)
+	{
+		uint64 Hash = MakeSeed(Spline.Points.Num(), IsLinear(Spline), Spline.bIsClosedLoop);
+		for (const FSlateSplinePoint& Point : Spline.Points)
+		{
+			Hash = HashValue(Point.Location, Hash);
+			Hash = HashValue(Point.Direction, Hash);
+		}
+		return Hash;
+	}
+
+	static uint64 GetCurvesKey(const FSlateSplineCurves& Curves)
+	{
+		uint64 Hash = MakeSeed(Curves.Position.Points.Num(), IsLinear(Curves), Curves.Position.bIsLooped);
+		for (const FInterpCurvePointVector2D& Point : Curves.Position.Points)
+		{
+			Hash = HashValue(Point.OutVal, Hash);
+			Hash = HashValue(Point.LeaveTangent, Hash);
+		}
+		return Hash;
+	}
+
+	static bool AreCurvesBuiltFrom(const FSlateSplineCurves& Curves, const FSlateSpline& Spline)
+	{
+		const TArray<FInterpCurvePointVector2D>& Points = Curves.Position.Points;
+		if (Curves.ReparamStepsPerSegment != ReparamStepsPerSegment || Points.Num() != Spline.Points.Num()
+			|| Curves.Position.bIsLooped != Spline.bIsClosedLoop || IsLinear(Curves) != IsLinear(Spline))
+		{
+			return false;
+		}
+
+		for (int32 i = 0; i < Points.Num(); i++)
+		{
+			if (Points[i].OutVal != Spline.Points[i].Location || Points[i].LeaveTangent != Spline.Points[i].Direction)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static uint64 GetGeometryKey(const FSlateSpline& Spline, FColor TintColor, FColor EffectiveFillColor)
+	{
+		uint64 Hash = GetCurvesKey(Spline);
+		for (const FSlateSplinePoint& Point : Spline.Points)
+		{
+			Hash = HashValue(Point.Width, Hash);
+			Hash = HashValue(Point.Color, Hash);
+		}
+		Hash = HashValue(Spline.Brush.GetImageSize(), Hash);
+		Hash = HashValue(TintColor, Hash);
+		return HashValue(EffectiveFillColor, Hash);
+	}
+}
+
+template<typename ValueType>
+TSharedRef<const ValueType> FSplineGeometryRegistry::TEntryMap<ValueType>::Add(uint64 Key, const TSharedRef<const ValueType>& Value, TFunctionRef<bool(const ValueType&)> IsMatch)
+{
+	// Another widget may have added the same entry while this one was built
+	TWeakPtr<const ValueType>& Entry = Entries.FindOrAdd(Key);
+	const TSharedPtr<const ValueType> Existing = Entry.Pin();
+	if (Existing.IsValid() && IsMatch(*Existing))
+	{
+		return Existing.ToSharedRef();
+	}
+	Entry = Value;
+
+	if (Entries.Num() > PurgeThreshold)
+	{
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		PurgeThreshold = FMath::Max(64, Entries.Num() * 2);
+	}
+
+	return Value;
+}
+
+template<typename ValueType>
+int32 FSplineGeometryRegistry::TEntryMap<ValueType>::GetNumAlive() const
+{
+	int32 NumAlive = 0;
+	for (const auto& Pair : Entries)
+	{
+		NumAlive += Pair.Value.IsValid() ? 1 : 0;
+	}
+	return NumAlive;
+}
+
+FSplineGeometryRegistry& FSplineGeometryRegistry::Get()
+{
+	static FSplineGeometryRegistry Registry;
+	return Registry;
+}
+
+TSharedRef<const FSlateSplineCurves> FSplineGeometryRegistry::FindOrAddCurves(const FSlateSpline& Spline)
+{
+	const uint64 Key = SplineGeometryRegistry::GetCurvesKey(Spline);
+	const auto IsMatch = [&Spline](const FSlateSplineCurves& Curves) { return SplineGeometryRegistry::AreCurvesBuiltFrom(Curves, Spline); };
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (const TSharedPtr<const FSlateSplineCurves> Existing = CurveEntries.Find(Key, IsMatch))
+		{
+			return Existing.ToSharedRef();
+		}
+	}
+
+	// Built outside the lock, so widgets building different splines do not wait on each other
+	const TSharedRef<FSlateSplineCurves> Built = MakeShared<FSlateSplineCurves>();
+	Built->UpdateSpline(Spline, SplineGeometryRegistry::ReparamStepsPerSegment);
+	Built->Version = ++SplineGeometryRegistry::NextCurvesVersion;
+
+	FScopeLock Lock(&CriticalSection);
+	return CurveEntries.Add(Key, Built, IsMatch);
+}
+
+TSharedPtr<const FSlateSplineCurves> FSplineGeometryRegistry::FindCurves(const FSlateSpline& Spline) const
+{
+	const uint64 Key = SplineGeometryRegistry::GetCurvesKey(Spline);
+	FScopeLock Lock(&CriticalSection);
+	return CurveEntries.Find(Key, [&Spline](const FSlateSplineCurves& Curves) { return SplineGeometryRegistry::AreCurvesBuiltFrom(Curves, Spline); });
+}
+
+TSharedRef<const FSlateSplineCurves> FSplineGeometryRegistry::AddCurves(FSlateSplineCurves&& InCurves)
+{
+	const uint64 Key = SplineGeometryRegistry::GetCurvesKey(InCurves);
+	const TSharedRef<FSlateSplineCurves> Added = MakeShared<FSlateSplineCurves>(MoveTemp(InCurves));
+	Added->Version = ++SplineGeometryRegistry::NextCurvesVersion;
+
+	FScopeLock Lock(&CriticalSection);
+	return CurveEntries.Add(Key, Added, [&Added](const FSlateSplineCurves& Curves)
+	{
+		return Curves.ReparamStepsPerSegment == Added->ReparamStepsPerSegment && Curves.Position == Added->Position;
+	});
+}
+
+TSharedRef<const FSplineGeometry> FSplineGeometryRegistry::FindOrAddGeometry(const FSlateSpline& Spline, FColor TintColor, FColor FillColor)
+{
+	const FColor EffectiveFillColor = FSplineTessellation::GetEffectiveFillColor(Spline, FillColor);
+	const uint64 Key = SplineGeometryRegistry::GetGeometryKey(Spline, TintColor, EffectiveFillColor);
+	const auto IsMatch = [&Spline, TintColor, EffectiveFillColor](const FSplineGeometry& Geometry) { return Geometry.IsBuiltFrom(Spline, TintColor, EffectiveFillColor); };
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (const TSharedPtr<const FSplineGeometry> Existing = GeometryEntries.Find(Key, IsMatch))
+		{
+			return Existing.ToSharedRef();
+		}
+	}
+
+	const TSharedRef<const FSplineGeometry> Built = FSplineTessellation::BuildGeometry(Spline, TintColor, EffectiveFillColor);
+
+	FScopeLock Lock(&CriticalSection);
+	return GeometryEntries.Add(Key, Built, IsMatch);
+}
+
+TSharedPtr<const FSplineGeometry> FSplineGeometryRegistry::FindGeometry(const FSlateSpline& Spline, FColor TintColor, FColor FillColor) const
+{
+	const FColor EffectiveFillColor = FSplineTessellation::GetEffectiveFillColor(Spline, FillColor);
+	const uint64 Key = SplineGeometryRegistry::GetGeometryKey(Spline, TintColor, EffectiveFillColor);
+	FScopeLock Lock(&CriticalSection);
+	return GeometryEntries.Find(Key, [&Spline, TintColor, EffectiveFillColor](const FSplineGeometry& Geometry) { return Geometry.IsBuiltFrom(Spline, TintColor, EffectiveFillColor); });
+}
+
+void FSplineGeometryRegistry::SerializeCurves(FArchive& Ar, TSharedPtr<const FSlateSplineCurves>& Curves)
+{
+	bool bHasCurves = Curves.IsValid();
+	Ar << bHasCurves;
+
+	if (Ar.IsLoading())
+	{
+		Curves.Reset();
+		if (bHasCurves)
+		{
+			FSlateSplineCurves LoadedCurves;
+			FSlateSplineCurves::StaticStruct()->SerializeItem(Ar, &LoadedCurves, nullptr);
+			if (!Ar.IsError())
+			{
+				Curves = Get().AddCurves(MoveTemp(LoadedCurves));
+			}
+		}
+	}
+	else if (bHasCurves)
+	{
+		// Saving only reads the curves
+		FSlateSplineCurves::StaticStruct()->SerializeItem(Ar, const_cast<FSlateSplineCurves*>(Curves.Get()), nullptr);
+	}
+}
+
+int32 FSplineGeometryRegistry::GetNumCurves() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return CurveEntries.GetNumAlive();
+}
+
+int32 FSplineGeometryRegistry::GetNumGeometries() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return GeometryEntries.GetNumAlive();
+}
@@ -0,0 +1,71 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SplineHitTester.h"
+
+void FSplineHitTester::Build(const FSlateSplineCurves& Curves, const FSlateSpline& Spline, const TOptional<uint32>& InSplineVersion)
+{
+	bIsValid = InSplineVersion.IsSet();
+	SplineVersion = InSplineVersion.Get(0);
+	BrushWidth = Spline.Brush.GetImageSize().X;
+	HalfThicknesses.Reset();
+	MaxHalfThickness = 0.0f;
+
+	// Curves built from other points cannot be hit until they are rebuilt
+	const int32 NumPoints = Spline.Points.Num();
+	if (Curves.Position.Points.Num() != NumPoints)
+	{
+		SegmentIndex = FSlateSplineSegmentIndex();
+		return;
+	}
+	SegmentIndex.Build(Curves);
+
+	// Point widths are interpolated along each segment of the curve
+	const float HalfBrushWidth = BrushWidth * 0.5f;
+	const TArray<float>& InputKeys = SegmentIndex.GetInputKeys();
+	HalfThicknesses.SetNumUninitialized(InputKeys.Num());
+	for (int32 VertexIndex = 0; VertexIndex < InputKeys.Num(); VertexIndex++)
+	{
+		const int32 StartIndex = FMath::Min(FMath::FloorToInt(InputKeys[VertexIndex]), NumPoints - 1);
+		const float Alpha = InputKeys[VertexIndex] - StartIndex;
+		const float Width = FMath::Lerp(Spline.Points[StartIndex].Width, Spline.Points[(StartIndex + 1) % NumPoints].Width, Alpha);
+		HalfThicknesses[VertexIndex] = HalfBrushWidth * Width;
+		MaxHalfThickness = FMath::Max(MaxHalfThickness, HalfThicknesses[VertexIndex]);
+	}
+}
+
+bool FSplineHitTester::IsBuiltFor(const TOptional<uint32>& InSplineVersion, float InBrushWidth) const
+{
+	return bIsValid && InSplineVersion.IsSet() && InSplineVersion.GetValue() == SplineVersion && InBrushWidth == BrushWidth;
+}
+
+bool FSplineHitTester::HitTest(const FVector2D& Position, float Tolerance, FSplineHitResult& OutHit) const
+{
+	const TArray<FVector2D>& Locations = SegmentIndex.GetLocations();
+	const TArray<float>& InputKeys = SegmentIndex.GetInputKeys();
+	float ClosestDistance = TNumericLimits<float>::Max();
+
+	// Only segments whose bounds are within the thickest part of the stroke can be hit
+	SegmentIndex.ForEachSegmentNear(Position, MaxHalfThickness + Tolerance, [&](int32 SegmentIndexToTest)
+	{
+		const FVector2D& Start = Locations[SegmentIndexToTest];
+		const FVector2D& End = Locations[SegmentIndexToTest + 1];
+		const FVector2D Closest = FMath::ClosestPointOnSegment2D(Position, Start, End);
+		const float Distance = FVector2D::Distance(Position, Closest);
+		if (Distance >= ClosestDistance)
+		{
+			return;
+		}
+
+		const float SegmentLength = FVector2D::Distance(Start, End);
+		const float Alpha = SegmentLength > UE_SMALL_NUMBER ? FVector2D::Distance(Start, Closest) / SegmentLength : 0.0f;
+		if (Distance <= FMath::Lerp(HalfThicknesses[SegmentIndexToTest], HalfThicknesses[SegmentIndexToTest + 1], Alpha) + Tolerance)
+		{
+			ClosestDistance = Distance;
+			OutHit.Location = Closest;
+			OutHit.Distance = Distance;
+			OutHit.InputKey = FMath::Lerp(InputKeys[SegmentIndexToTest], InputKeys[SegmentIndexToTest + 1], Alpha);
+		}
+	});
+
+	return ClosestDistance < TNumericLimits<float>::Max();
+}
@@ -0,0 +1,305 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Slate/SplineTessellation.h"
+
+#include "Slate/SplineBuilder.h"
+#include "Slate/SplineBuildScheduler.h"
+#include "Slate/SplineGeometryRegistry.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarSplineAsyncTessellationMinPoints(
+	TEXT("Slate.SplineAsyncTessellationMinPoints"),
+	128,
+	TEXT("Splines with at least this many points are tessellated on worker threads. 0 tessellates every spline on the game thread."));
+
+namespace SplineTessellation
+{
+	static const FSplineGeometry EmptyGeometry;
+}
+
+/** Tessellation running on a worker thread. Only the game thread cancels it, and only the game thread reads the flag once it is done. */
+struct FSplineTessellationJob
+{
+	std::atomic<bool> bIsCancelled{false};
+	TSharedPtr<const FSplineGeometry> Result;
+};
+
+FSplineTessellation::~FSplineTessellation()
+{
+	CancelPending();
+}
+
+void FSplineTessellation::Update(const FSlateSpline& Spline, const TOptional<uint32>& SplineVersion, const FColor InTintColor, const FColor InFillColor)
+{
+	const FVector2D InBrushSize = Spline.Brush.GetImageSize();
+	const FColor EffectiveFillColor = GetEffectiveFillColor(Spline, InFillColor);
+	if (SplineVersion.IsSet() && IsUpToDate(SplineVersion.GetValue(), InBrushSize, InTintColor, EffectiveFillColor))
+	{
+		return;
+	}
+
+	CancelPending();
+	SetGeometry(FSplineGeometryRegistry::Get().FindOrAddGeometry(Spline, InTintColor, EffectiveFillColor), SplineVersion.Get(0), InBrushSize, InTintColor, EffectiveFillColor);
+}
+
+bool FSplineTessellation::UpdateDeferred(const FSlateSpline& Spline, const TOptional<uint32>& SplineVersion, const FColor InTintColor, const FColor InFillColor, TFunction<void()>&& OnBuilt)
+{
+	FSplineBuildScheduler& Scheduler = FSplineBuildScheduler::Get();
+	const int32 AsyncMinPoints = CVarSplineAsyncTessellationMinPoints.GetValueOnGameThread();
+	const bool bIsAsync = AsyncMinPoints > 0 && Spline.Points.Num() >= AsyncMinPoints;
+	if (!SplineVersion.IsSet() || (!bIsAsync && !Scheduler.IsTimeSliced()))
+	{
+		Update(Spline, SplineVersion, InTintColor, InFillColor);
+		return true;
+	}
+
+	const uint32 InVersion = SplineVersion.GetValue();
+	const FVector2D InBrushSize = Spline.Brush.GetImageSize();
+	const FColor EffectiveFillColor = GetEffectiveFillColor(Spline, InFillColor);
+	if (IsUpToDate(InVersion, InBrushSize, InTintColor, EffectiveFillColor))
+	{
+		return true;
+	}
+
+	if (const TSharedPtr<const FSplineGeometry> SharedGeometry = FSplineGeometryRegistry::Get().FindGeometry(Spline, InTintColor, EffectiveFillColor))
+	{
+		SetGeometry(SharedGeometry.ToSharedRef(), InVersion, InBrushSize, InTintColor, EffectiveFillColor);
+		return true;
+	}
+
+	const bool bIsPending = PendingJob.IsValid() || (PendingBuild.IsValid() && PendingBuild->IsPending());
+	if (bIsPending && PendingVersion == InVersion && PendingBrushSize == InBrushSize && PendingTintColor == InTintColor && PendingFillColor == EffectiveFillColor)
+	{
+		return Geometry.IsValid();
+	}
+
+	CancelPending();
+	PendingVersion = InVersion;
+	PendingBrushSize = InBrushSize;
+	PendingTintColor = InTintColor;
+	PendingFillColor = EffectiveFillColor;
+	if (bIsAsync)
+	{
+		LaunchJob(Spline, InVersion, InBrushSize, InTintColor, EffectiveFillColor, MoveTemp(OnBuilt));
+	}
+	else
+	{
+		// The request is owned by this tessellation, so the build never outlives it
+		PendingBuild = Scheduler.Enqueue([this, Spline, InVersion, InBrushSize, InTintColor, EffectiveFillColor, OnBuilt = MoveTemp(OnBuilt)]()
+		{
+			SetGeometry(FSplineGeometryRegistry::Get().FindOrAddGeometry(Spline, InTintColor, EffectiveFillColor), InVersion, InBrushSize, InTintColor, EffectiveFillColor);
+			OnBuilt();
+		});
+	}
+	return Geometry.IsValid();
+}
+
+void FSplineTessellation::LaunchJob(const FSlateSpline& Spline, uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor, TFunction<void()>&& OnBuilt)
+{
+	const TSharedRef<FSplineTessellationJob> Job = MakeShared<FSplineTessellationJob>();
+	PendingJob = Job;
+
+	// Workers never see the brush resource, only what the geometry is built from
+	FSlateSpline Snapshot;
+	Snapshot.Points = Spline.Points;
+	Snapshot.bIsLinear = Spline.bIsLinear;
+	Snapshot.bIsClosedLoop = Spline.bIsClosedLoop;
+	Snapshot.Brush.ImageSize = InBrushSize;
+
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Job, Snapshot = MoveTemp(Snapshot), SplineVersion, InBrushSize, InTintColor, InFillColor, OnBuilt = MoveTemp(OnBuilt)]() mutable
+	{
+		if (Job->bIsCancelled)
+		{
+			return;
+		}
+
+		Job->Result = FSplineGeometryRegistry::Get().FindOrAddGeometry(Snapshot, InTintColor, InFillColor);
+
+		// Swapped in on the game thread, which cancels the job before this tessellation can be destroyed
+		AsyncTask(ENamedThreads::GameThread, [this, Job, SplineVersion, InBrushSize, InTintColor, InFillColor, OnBuilt = MoveTemp(OnBuilt)]()
+		{
+			if (!Job->bIsCancelled)
+			{
+				PendingJob.Reset();
+				SetGeometry(Job->Result.ToSharedRef(), SplineVersion, InBrushSize, InTintColor, InFillColor);
+				OnBuilt();
+			}
+		});
+	});
+}
+
+void FSplineTessellation::CancelPending()
+{
+	if (PendingJob.IsValid())
+	{
+		PendingJob->bIsCancelled = true;
+		PendingJob.Reset();
+	}
+	PendingBuild.Reset();
+}
+
+void FSplineTessellation::Invalidate()
+{
+	bIsValid = false;
+	CancelPending();
+}
+
+bool FSplineTessellation::IsUpToDate(uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor) const
+{
+	return bIsValid && Version == SplineVersion && BrushSize == InBrushSize && TintColor == InTintColor && FillColor == InFillColor;
+}
+
+void FSplineTessellation::SetGeometry(const TSharedRef<const FSplineGeometry>& InGeometry, uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor)
+{
+	Geometry = InGeometry;
+	Version = SplineVersion;
+	BrushSize = InBrushSize;
+	TintColor = InTintColor;
+	FillColor = InFillColor;
+	bIsValid = true;
+}
+
+FColor FSplineTessellation::GetEffectiveFillColor(const FSlateSpline& Spline, const FColor InFillColor)
+{
+	return Spline.bIsClosedLoop && InFillColor.A > 0 ? InFillColor : FColor::Transparent;
+}
+
+TSharedRef<const FSplineGeometry> FSplineTessellation::BuildGeometry(const FSlateSpline& Spline, const FColor TintColor, const FColor InFillColor)
+{
+	FSplineBuilder SplineBuilder(Spline.Brush.GetImageSize(), FSlateRenderTransform(), TintColor);
+	
+	for (int i = 0; i < Spline.Points.Num() - 1; i++)
+	{
+		SplineBuilder.BuildBezierGeometry(Spline.Points[i], Spline.Points[i + 1], Spline.bIsLinear);
+	}
+	
+	if (Spline.bIsClosedLoop)
+	{
+		SplineBuilder.BuildBezierGeometry(Spline.Points.Last(), Spline.Points[0], Spline.bIsLinear);
+	}
+
+	SplineBuilder.Finish(Spline.bIsClosedLoop);
+
+	const FColor EffectiveFillColor = GetEffectiveFillColor(Spline, InFillColor);
+	if (EffectiveFillColor.A > 0)
+	{
+		SplineBuilder.BuildFill(EffectiveFillColor);
+	}
+
+	const TSharedRef<FSplineGeometry> Built = MakeShared<FSplineGeometry>();
+	Built->Vertices = MoveTemp(SplineBuilder.GetVertexArray());
+	Built->Indices = MoveTemp(SplineBuilder.GetIndexArray());
+	Built->NumFillVertices = SplineBuilder.GetNumFillVertices();
+	Built->NumFillIndices = SplineBuilder.GetNumFillIndices();
+	Built->SourcePoints = Spline.Points;
+	Built->bIsLinear = Spline.bIsLinear;
+	Built->bIsClosedLoop = Spline.bIsClosedLoop;
+	Built->BrushSize = Spline.Brush.GetImageSize();
+	Built->TintColor = TintColor;
+	Built->FillColor = EffectiveFillColor;
+	return Built;
+}
+
+bool FSplineGeometry::IsBuiltFrom(const FSlateSpline& Spline, const FColor InTintColor, const FColor InFillColor) const
+{
+	if (bIsLinear != Spline.bIsLinear || bIsClosedLoop != Spline.bIsClosedLoop || BrushSize != Spline.Brush.GetImageSize()
+		|| TintColor != InTintColor || FillColor != FSplineTessellation::GetEffectiveFillColor(Spline, InFillColor)
+		|| SourcePoints.Num() != Spline.Points.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < SourcePoints.Num(); i++)
+	{
+		const FSlateSplinePoint& Point = SourcePoints[i];
+		const FSlateSplinePoint& Other = Spline.Points[i];
+		if (Point.Location != Other.Location || Point.Direction != Other.Direction || Point.Width != Other.Width || Point.Color != Other.Color)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const TArray<FSlateVertex>& FSplineTessellation::GetVertices() const
+{
+	return Geometry.IsValid() ? Geometry->Vertices : SplineTessellation::EmptyGeometry.Vertices;
+}
+
+const TArray<SlateIndex>& FSplineTessellation::GetIndices() const
+{
+	return Geometry.IsValid() ? Geometry->Indices : SplineTessellation::EmptyGeometry.Indices;
+}
+
+void FSplineTessellation::PaintBrush(const FSlatePaintContext& PaintContext, const FSlateResourceHandle& ResourceHandle, const FSlateRenderTransform& SplineToRender, float UVOffset)
+{
+	// The fill samples a fixed point of the brush, only the stroke scrolls
+	const TArray<FSlateVertex>& Vertices = GetVertices();
+	const int32 NumFillVertices = Geometry.IsValid() ? Geometry->NumFillVertices : 0;
+	PaintVertices.SetNumUninitialized(Vertices.Num());
+	for (int32 i = 0; i < Vertices.Num(); i++)
+	{
+		FSlateVertex& Vertex = PaintVertices[i];
+		Vertex = Vertices[i];
+		Vertex.Position = SplineToRender.TransformPoint(Vertex.Position);
+		if (i >= NumFillVertices)
+		{
+			Vertex.TexCoords[1] += UVOffset;
+		}
+	}
+
+	FSlateDrawElement::MakeCustomVerts(PaintContext.OutDrawElements, PaintContext.LayerId, ResourceHandle, PaintVertices, GetIndices(), nullptr, 0, 0, PaintContext.DrawEffect);
+}
+
+void FSplineTessellation::PaintFill(const FSlatePaintContext& PaintContext, const FSlateRenderTransform& SplineToRender)
+{
+	if (!Geometry.IsValid() || Geometry->NumFillIndices == 0)
+	{
+		return;
+	}
+
+	PaintVertices.SetNumUninitialized(Geometry->NumFillVertices);
+	for (int32 i = 0; i < Geometry->NumFillVertices; i++)
+	{
+		FSlateVertex& Vertex = PaintVertices[i];
+		Vertex = Geometry->Vertices[i];
+		Vertex.Position = SplineToRender.TransformPoint(Vertex.Position);
+	}
+	PaintIndices.Reset(Geometry->NumFillIndices);
+	PaintIndices.Append(Geometry->Indices.GetData(), Geometry->NumFillIndices);
+
+	FSlateDrawElement::MakeCustomVerts(PaintContext.OutDrawElements, PaintContext.LayerId, FSlateResourceHandle(), PaintVertices, PaintIndices, nullptr, 0, 0, PaintContext.DrawEffect);
+}
+
+void FSplineTessellation::PaintSimple(const FSlatePaintContext& PaintContext, const FSlateSpline& Spline, const FPaintGeometry& SplinePaintGeometry)
+{
+	const auto& DrawSplineSegment = [&](const FSlateSplinePoint& SegmentStart, const FSlateSplinePoint& SegmentEnd){
+		const FVector2D& SegmentStartDirection = Spline.bIsLinear ? FVector2D::ZeroVector : SegmentStart.Direction;
+		const FVector2D& SegmentEndDirection = Spline.bIsLinear ? FVector2D::ZeroVector : SegmentEnd.Direction;
+		FSlateDrawElement::MakeSpline(
+				PaintContext.OutDrawElements,
+				PaintContext.LayerId,
+				SplinePaintGeometry,
+				SegmentStart.Location,
+				SegmentStartDirection,
+				SegmentEnd.Location,
+				SegmentEndDirection,
+				Spline.Brush.GetImageSize().X * SegmentStart.Width,
+				PaintContext.DrawEffect,
+				SegmentStart.Color == FLinearColor::White ? PaintContext.TintColor : (FLinearColor(PaintContext.TintColor) * SegmentStart.Color).ToFColorSRGB());
+	};
+	
+	for (int i = 0; i < Spline.Points.Num() - 1; i++)
+	{
+		DrawSplineSegment(Spline.Points[i], Spline.Points[i + 1]);
+	}
+	
+	if (Spline.bIsClosedLoop)
+	{
+		DrawSplineSegment(Spline.Points.Last(), Spline.Points[0]);
+	}
+}
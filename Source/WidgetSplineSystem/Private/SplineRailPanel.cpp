@@ -0,0 +1,144 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineRailPanel.h"
+
+#include "SplineRailPanelSlot.h"
+#include "Data/SlateSplineCustomVersion.h"
+#include "Slate/SSplineRailPanel.h"
+#include "Slate/SplineGeometryRegistry.h"
+#include "UObject/ObjectSaveContext.h"
+
+USplineRailPanel::USplineRailPanel()
+{
+	bIsVariable = false;
+	SetVisibilityInternal(ESlateVisibility::SelfHitTestInvisible);
+}
+
+USplineRailPanelSlot* USplineRailPanel::AddChildToRail(UWidget* Content)
+{
+	return Cast<USplineRailPanelSlot>(Super::AddChild(Content));
+}
+
+void USplineRailPanel::UpdateSpline()
+{
+	PendingCurvesBuild.Reset();
+	SplineCurves = FSplineGeometryRegistry::Get().FindOrAddCurves(SplineData);
+	if (MyRailPanel.IsValid())
+	{
+		MyRailPanel->Invalidate(EInvalidateWidgetReason::Layout);
+	}
+}
+
+void USplineRailPanel::SetSplineData(const FSlateSpline& InSplineData)
+{
+	SplineData = InSplineData;
+	MarkSplineDirty();
+}
+
+void USplineRailPanel::MarkSplineDirty()
+{
+	PendingCurvesBuild = FSplineBuildScheduler::Get().EnqueueCurves(SplineData, [this]() { UpdateSpline(); });
+}
+
+UClass* USplineRailPanel::GetSlotClass() const
+{
+	return USplineRailPanelSlot::StaticClass();
+}
+
+void USplineRailPanel::OnSlotAdded(UPanelSlot* InSlot)
+{
+	if (MyRailPanel.IsValid())
+	{
+		CastChecked<USplineRailPanelSlot>(InSlot)->BuildSlot(MyRailPanel.ToSharedRef());
+	}
+}
+
+void USplineRailPanel::OnSlotRemoved(UPanelSlot* InSlot)
+{
+	if (MyRailPanel.IsValid() && InSlot->Content)
+	{
+		const TSharedPtr<SWidget> Widget = InSlot->Content->GetCachedWidget();
+		if (Widget.IsValid())
+		{
+			MyRailPanel->RemoveSlot(Widget.ToSharedRef());
+		}
+	}
+}
+
+void USplineRailPanel::OnWidgetRebuilt()
+{
+	// Curves loaded with the widget only have to be validated, and curves another widget holds only have to be looked up
+	if (!SplineCurves.IsValid() || !SplineCurves->IsBuiltFrom(SplineData))
+	{
+		SplineCurves = FSplineGeometryRegistry::Get().FindCurves(SplineData);
+		if (!SplineCurves.IsValid())
+		{
+			PendingCurvesBuild = FSplineBuildScheduler::Get().Enqueue([this]() { UpdateSpline(); });
+		}
+	}
+}
+
+void USplineRailPanel::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	if (!SplineCurves.IsValid() || !SplineCurves->IsBuiltFrom(SplineData))
+	{
+		UpdateSpline();
+	}
+}
+
+void USplineRailPanel::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar.UsingCustomVersion(FSlateSplineCustomVersion::GUID);
+	if (Ar.IsPersistent() && !Ar.IsTransacting() && !Ar.IsTextFormat() && !Ar.HasAnyPortFlags(PPF_Duplicate)
+		&& Ar.CustomVer(FSlateSplineCustomVersion::GUID) >= FSlateSplineCustomVersion::SharedCurves)
+	{
+		FSplineGeometryRegistry::SerializeCurves(Ar, SplineCurves);
+	}
+}
+
+TSharedRef<SWidget> USplineRailPanel::RebuildWidget()
+{
+	MyRailPanel = SNew(SSplineRailPanel)
+		.OnGetSplineCurves_UObject(this, &USplineRailPanel::GetSplineCurvesPtr);
+
+	for (UPanelSlot* PanelSlot : Slots)
+	{
+		if (USplineRailPanelSlot* TypedSlot = Cast<USplineRailPanelSlot>(PanelSlot))
+		{
+			TypedSlot->Parent = this;
+			TypedSlot->BuildSlot(MyRailPanel.ToSharedRef());
+		}
+	}
+
+	return MyRailPanel.ToSharedRef();
+}
+
+void USplineRailPanel::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	MyRailPanel.Reset();
+}
+
+#if WITH_EDITOR
+void USplineRailPanel::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(USplineRailPanel, SplineData))
+	{
+		// Points dragged in the edit panel are only built once per frame, finished edits right away
+		if (PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive)
+		{
+			MarkSplineDirty();
+		}
+		else
+		{
+			UpdateSpline();
+		}
+	}
+}
+#endif
@@ -0,0 +1,68 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineRailPanelSlot.h"
+
+#include "Components/Widget.h"
+
+void USplineRailPanelSlot::SetPosition(float InPosition)
+{
+	Position = InPosition;
+	if (Slot)
+	{
+		Slot->SetPosition(Position);
+	}
+}
+
+void USplineRailPanelSlot::SetUseNormalizedPosition(bool bInUseNormalizedPosition)
+{
+	bUseNormalizedPosition = bInUseNormalizedPosition;
+	if (Slot)
+	{
+		Slot->SetIsPositionNormalized(bUseNormalizedPosition);
+	}
+}
+
+void USplineRailPanelSlot::SetAlignment(FVector2D InAlignment)
+{
+	Alignment = InAlignment;
+	if (Slot)
+	{
+		Slot->SetAlignment(Alignment);
+	}
+}
+
+void USplineRailPanelSlot::SetOrientToTangent(bool bInOrientToTangent)
+{
+	bOrientToTangent = bInOrientToTangent;
+	if (Slot)
+	{
+		Slot->SetOrientToTangent(bOrientToTangent);
+	}
+}
+
+void USplineRailPanelSlot::BuildSlot(TSharedRef<SSplineRailPanel> InRailPanel)
+{
+	InRailPanel->AddSlot()
+		.Expose(Slot)
+		.Position(Position)
+		.bIsPositionNormalized(bUseNormalizedPosition)
+		.Alignment(Alignment)
+		.bOrientToTangent(bOrientToTangent)
+		[
+			Content == nullptr ? SNullWidget::NullWidget : Content->TakeWidget()
+		];
+}
+
+void USplineRailPanelSlot::SynchronizeProperties()
+{
+	SetPosition(Position);
+	SetUseNormalizedPosition(bUseNormalizedPosition);
+	SetAlignment(Alignment);
+	SetOrientToTangent(bOrientToTangent);
+}
+
+void USplineRailPanelSlot::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	Slot = nullptr;
+}
@@ -0,0 +1,100 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineTextWidget.h"
+
+#include "Slate/SSplineText.h"
+#include "Styling/CoreStyle.h"
+
+USplineTextWidget::USplineTextWidget()
+{
+	Font = FCoreStyle::GetDefaultFontStyle("Regular", 24);
+}
+
+TSharedRef<SWidget> USplineTextWidget::RebuildWidget()
+{
+	SlateSplineText = SNew(SSplineText)
+		.OnGetSpline_UObject(this, &USplineWidget::GetSplineDataPtr)
+		.SplineVersion_UObject(this, &USplineTextWidget::GetSplineVersion)
+		.bDrawPolylineWhileBuilding(bDrawPolylineWhileBuilding)
+		.OnGetSplineCurves_UObject(this, &USplineWidget::GetSplineCurvesPtr)
+		.OnClicked_UObject(this, &USplineTextWidget::HandleClicked)
+		.OnHovered_UObject(this, &USplineTextWidget::HandleHovered)
+		.OnUnhovered_UObject(this, &USplineTextWidget::HandleUnhovered);
+	SlateSpline = SlateSplineText;
+	return SlateSplineText.ToSharedRef();
+}
+
+void USplineTextWidget::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetText(Text);
+		SlateSplineText->SetFont(Font);
+		SlateSplineText->SetColorAndOpacity(ColorAndOpacity);
+		SlateSplineText->SetStartDistance(StartDistance);
+		SlateSplineText->SetBaselineOffset(BaselineOffset);
+		SlateSplineText->SetDrawSpline(bDrawSpline);
+	}
+}
+
+void USplineTextWidget::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+	SlateSplineText.Reset();
+}
+
+void USplineTextWidget::SetText(const FText& InText)
+{
+	Text = InText;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetText(Text);
+	}
+}
+
+void USplineTextWidget::SetFont(const FSlateFontInfo& InFont)
+{
+	Font = InFont;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetFont(Font);
+	}
+}
+
+void USplineTextWidget::SetColorAndOpacity(const FSlateColor& InColorAndOpacity)
+{
+	ColorAndOpacity = InColorAndOpacity;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetColorAndOpacity(ColorAndOpacity);
+	}
+}
+
+void USplineTextWidget::SetStartDistance(float InStartDistance)
+{
+	StartDistance = InStartDistance;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetStartDistance(StartDistance);
+	}
+}
+
+void USplineTextWidget::SetBaselineOffset(float InBaselineOffset)
+{
+	BaselineOffset = InBaselineOffset;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetBaselineOffset(BaselineOffset);
+	}
+}
+
+void USplineTextWidget::SetDrawSpline(bool bInDrawSpline)
+{
+	bDrawSpline = bInDrawSpline;
+	if (SlateSplineText.IsValid())
+	{
+		SlateSplineText->SetDrawSpline(bDrawSpline);
+	}
+}
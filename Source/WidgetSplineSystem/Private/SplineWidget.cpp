@@ -2,17 +2,81 @@
 
 #include "SplineWidget.h"
 
+#include "Data/SlateSplineCustomVersion.h"
+#include "Slate/SplineGeometryRegistry.h"
+#include "UObject/ObjectSaveContext.h"
+
+static const FSlateSplineCurves EmptySplineCurves;
+
 void USplineWidget::OnWidgetRebuilt()
 {
-	UpdateSpline();
+	// Curves loaded with the widget only have to be validated, and curves another widget holds only have to be looked up.
+	// Others are built by the build scheduler, which owns no reference to this widget: the request is cancelled with it.
+	const TSharedPtr<const FSlateSplineCurves>& Curves = CurvesPublisher.GetPublished();
+	if (!Curves.IsValid() || !Curves->IsBuiltFrom(SplineData))
+	{
+		CurvesPublisher.Publish(FSplineGeometryRegistry::Get().FindCurves(SplineData));
+		if (!CurvesPublisher.GetPublished().IsValid())
+		{
+			PendingCurvesBuild = FSplineBuildScheduler::Get().Enqueue([this]() { UpdateSpline(); });
+		}
+	}
+}
+
+void USplineWidget::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	const TSharedPtr<const FSlateSplineCurves>& Curves = CurvesPublisher.GetPublished();
+	if (!Curves.IsValid() || !Curves->IsBuiltFrom(SplineData))
+	{
+		UpdateSpline();
+	}
+}
+
+void USplineWidget::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// Duplicated widgets, such as the instances of a widget blueprint, find the curves of their template in the registry instead
+	Ar.UsingCustomVersion(FSlateSplineCustomVersion::GUID);
+	if (Ar.IsPersistent() && !Ar.IsTransacting() && !Ar.IsTextFormat() && !Ar.HasAnyPortFlags(PPF_Duplicate)
+		&& Ar.CustomVer(FSlateSplineCustomVersion::GUID) >= FSlateSplineCustomVersion::SharedCurves)
+	{
+		TSharedPtr<const FSlateSplineCurves> Curves = CurvesPublisher.GetPublished();
+		FSplineGeometryRegistry::SerializeCurves(Ar, Curves);
+		if (Ar.IsLoading())
+		{
+			CurvesPublisher.Publish(Curves);
+		}
+	}
 }
 
 TSharedRef<SWidget> USplineWidget::RebuildWidget()
 {
-	SlateSpline = SNew(SSpline).Spline_UObject(this, &USplineWidget::GetSplineData);
+	SlateSpline = SNew(SSpline)
+		.OnGetSpline_UObject(this, &USplineWidget::GetSplineDataPtr)
+		.SplineVersion_UObject(this, &USplineWidget::GetSplineVersion)
+		.OnGetSplineCurves_UObject(this, &USplineWidget::GetSplineCurvesPtr)
+		.bDrawPolylineWhileBuilding(bDrawPolylineWhileBuilding)
+		.OnClicked_UObject(this, &USplineWidget::HandleClicked)
+		.OnHovered_UObject(this, &USplineWidget::HandleHovered)
+		.OnUnhovered_UObject(this, &USplineWidget::HandleUnhovered);
 	return SlateSpline.ToSharedRef();
 }
 
+void USplineWidget::SynchronizeProperties()
+{
+	Super::SynchronizeProperties();
+
+	if (SlateSpline.IsValid())
+	{
+		SlateSpline->SetUVScroll(UVOffset, UVScrollSpeed);
+		SlateSpline->SetFillColor(FillColor);
+		SlateSpline->SetHitTestStroke(bHitTestStroke, HitTolerance);
+	}
+}
+
 void USplineWidget::ReleaseSlateResources(bool bReleaseChildren)
 {
 	Super::ReleaseSlateResources(bReleaseChildren);
@@ -21,5 +85,153 @@ void USplineWidget::ReleaseSlateResources(bool bReleaseChildren)
 
 void USplineWidget::UpdateSpline()
 {
-	SplineCurves.UpdateSpline(SplineData);
+	// Shared curves are never modified, a changed spline gets its own
+	PendingCurvesBuild.Reset();
+	CurvesPublisher.Publish(FSplineGeometryRegistry::Get().FindOrAddCurves(SplineData));
+	SplineRevision++;
+
+	if (SlateSpline.IsValid())
+	{
+		SlateSpline->Invalidate(EInvalidateWidgetReason::Paint);
+	}
+}
+
+const FSlateSplineCurves& USplineWidget::GetSplineCurves() const
+{
+	if (const TSharedPtr<FSplineBuildRequest> Request = PendingCurvesBuild)
+	{
+		Request->Flush();
+	}
+	const TSharedPtr<const FSlateSplineCurves>& Curves = CurvesPublisher.GetPublished();
+	return Curves.IsValid() ? *Curves : EmptySplineCurves;
+}
+
+FSlateSplineCurvesSnapshot USplineWidget::GetCurvesSnapshot() const
+{
+	if (IsInGameThread())
+	{
+		if (const TSharedPtr<FSplineBuildRequest> Request = PendingCurvesBuild)
+		{
+			Request->Flush();
+		}
+	}
+	return CurvesPublisher.GetSnapshot();
+}
+
+uint32 USplineWidget::GetSplineVersion() const
+{
+	return SplineRevision;
+}
+
+void USplineWidget::SetSplineData(const FSlateSpline& InSplineData)
+{
+	SplineData = InSplineData;
+	MarkSplineDirty();
+}
+
+void USplineWidget::MarkSplineDirty()
+{
+	PendingCurvesBuild = FSplineBuildScheduler::Get().EnqueueCurves(SplineData, [this]() { UpdateSpline(); });
+}
+
+void USplineWidget::SetUVOffset(float InUVOffset)
+{
+	UVOffset = InUVOffset;
+	if (SlateSpline.IsValid())
+	{
+		SlateSpline->SetUVScroll(UVOffset, UVScrollSpeed);
+	}
+}
+
+void USplineWidget::SetUVScrollSpeed(float InUVScrollSpeed)
+{
+	UVScrollSpeed = InUVScrollSpeed;
+	if (SlateSpline.IsValid())
+	{
+		SlateSpline->SetUVScroll(UVOffset, UVScrollSpeed);
+	}
+}
+
+void USplineWidget::SetFillColor(FLinearColor InFillColor)
+{
+	FillColor = InFillColor;
+	if (SlateSpline.IsValid())
+	{
+		SlateSpline->SetFillColor(FillColor);
+	}
+}
+
+void USplineWidget::BeginStroke(FVector2D Location)
+{
+	StrokeFitter.Reset(StrokeFitTolerance, StrokeFitTolerance);
+	StrokeFitter.AddSample(Location);
+	bIsStrokeActive = true;
+	UpdateStrokePoints();
+}
+
+void USplineWidget::AddStrokeSample(FVector2D Location)
+{
+	if (bIsStrokeActive)
+	{
+		StrokeFitter.AddSample(Location);
+		UpdateStrokePoints();
+	}
+}
+
+void USplineWidget::EndStroke()
+{
+	if (bIsStrokeActive)
+	{
+		StrokeFitter.Finish();
+		bIsStrokeActive = false;
+		UpdateStrokePoints();
+	}
+}
+
+bool USplineWidget::HitTestStroke(FVector2D Location, FSplineHitResult& OutHit) const
+{
+	return SlateSpline.IsValid() && SlateSpline->HitTestStroke(Location, OutHit);
+}
+
+void USplineWidget::HandleClicked(const FSplineHitResult& Hit)
+{
+	OnClicked.Broadcast(Hit);
+}
+
+void USplineWidget::HandleHovered(const FSplineHitResult& Hit)
+{
+	OnHovered.Broadcast(Hit);
+}
+
+void USplineWidget::HandleUnhovered()
+{
+	OnUnhovered.Broadcast();
+}
+
+void USplineWidget::UpdateStrokePoints()
+{
+	// Only the fitted points reach the spline, so updating it costs the same however many samples the stroke has.
+	// Samples arriving within the same frame share a single update.
+	StrokeFitter.GetPoints(SplineData.Points);
+	MarkSplineDirty();
+}
+
+#if WITH_EDITOR
+void USplineWidget::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(USplineWidget, SplineData))
+	{
+		// Points dragged in the edit panel are only built once per frame, finished edits right away
+		if (PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive)
+		{
+			MarkSplineDirty();
+		}
+		else
+		{
+			UpdateSpline();
+		}
+	}
 }
+#endif
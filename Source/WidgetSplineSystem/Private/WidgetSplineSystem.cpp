@@ -2,6 +2,8 @@
 
 #include "WidgetSplineSystem.h"
 
+#include "Slate/SplineBuildScheduler.h"
+
 #define LOCTEXT_NAMESPACE "FWidgetSplineSystemModule"
 
 void FWidgetSplineSystemModule::StartupModule()
@@ -13,6 +15,7 @@ void FWidgetSplineSystemModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FSplineBuildScheduler::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -5,6 +5,20 @@
 #include "SlateSplinePoint.h"
 #include "SlateSpline.generated.h"
 
+/** How the locations and directions of spline points are stored when a spline is saved. */
+UENUM(BlueprintType)
+enum class ESlateSplineQuantization : uint8
+{
+	/** Stored as they are, loaded back exactly. */
+	None,
+
+	/** Stored as floats relative to the minimum of their bounds. */
+	Float,
+
+	/** Stored as 16 bit fixed point within their bounds. */
+	Fixed16,
+};
+
 USTRUCT(BlueprintType)
 struct WIDGETSPLINESYSTEM_API FSlateSpline
 {
@@ -29,4 +43,29 @@ struct WIDGETSPLINESYSTEM_API FSlateSpline
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget")
 	FSlateBrush Brush = FSlateBrush();
-};
\ No newline at end of file
+
+	/** Precision of point locations and directions in saved packages. Widths and colors are always saved as they are. */
+	UPROPERTY(EditAnywhere, Category="Spline Widget", AdvancedDisplay)
+	ESlateSplineQuantization Quantization = ESlateSplineQuantization::None;
+
+	/**
+	 * Saves the points as one contiguous block per component instead of a tagged property per point.
+	 * Returns false to fall back to tagged properties, for packages saved before and for archives that do not persist.
+	 */
+	bool Serialize(FArchive& Ar);
+
+private:
+	void SerializePoints(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSlateSpline> : public TStructOpsTypeTraitsBase2<FSlateSpline>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
+/** Lets Slate widgets read a spline owned by a UObject without copying it on every query. */
+DECLARE_DELEGATE_RetVal(const FSlateSpline*, FOnGetSpline)
@@ -5,6 +5,24 @@
 
 // Based on FSplineCurves from SplineComponent.h
 
+/** Where two splines cross. */
+struct FSlateSplineIntersection
+{
+	FVector2D Location = FVector2D::ZeroVector;
+
+	/** Indices of the crossing curves in the array given to FindIntersections. Unset when only two curves were tested. */
+	int32 CurveIndexA = INDEX_NONE;
+	int32 CurveIndexB = INDEX_NONE;
+
+	/** Input key of each spline at the crossing. */
+	float InputKeyA = 0.0f;
+	float InputKeyB = 0.0f;
+
+	/** Distance along each spline to the crossing. */
+	float DistanceA = 0.0f;
+	float DistanceB = 0.0f;
+};
+
 USTRUCT(BlueprintType)
 struct WIDGETSPLINESYSTEM_API FSlateSplineCurves
 {
@@ -21,6 +39,22 @@ struct WIDGETSPLINESYSTEM_API FSlateSplineCurves
 	UPROPERTY()
 	int32 ReparamStepsPerSegment = 0;
 
+	/** Bezier control points of each segment, four per segment. */
+	UPROPERTY()
+	TArray<FVector2D> BezierPoints;
+
+	/** Tight bounds of each segment, including where the curve overshoots its points. */
+	UPROPERTY()
+	TArray<FBox2D> SegmentBounds;
+
+	/** Tight bounds of the whole spline. */
+	UPROPERTY()
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	/** Content hash of the spline data and parameters the curves were built from, saved so loaded curves are validated instead of rebuilt. */
+	UPROPERTY()
+	uint32 SourceHash = 0;
+
 	UPROPERTY(transient)
 	uint32 Version = 0xffffffff;
 
@@ -47,9 +81,79 @@ struct WIDGETSPLINESYSTEM_API FSlateSplineCurves
 	void UpdateSpline(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment = 10, bool bLoopPositionOverride = false, float
 	                  LoopPosition = 0.0f, const FVector2D& Scale2D = FVector2D(1.0f));
 
+	/** Returns whether the curves were built from this spline data with these parameters. Much cheaper than rebuilding them. */
+	bool IsBuiltFrom(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment = 10, bool bLoopPositionOverride = false, float
+	                 LoopPosition = 0.0f, const FVector2D& Scale2D = FVector2D(1.0f)) const;
+
+	/** Returns the tight bounds of a cubic Bezier segment, from its end points and the extrema of its curve. */
+	static FBox2D ComputeBezierBounds(const FVector2D& P0, const FVector2D& P1, const FVector2D& P2, const FVector2D& P3);
+
+	static uint32 ComputeSourceHash(const FSlateSpline& InSplineRef, int32 InReparamStepsPerSegment, bool bLoopPositionOverride, float
+	                                LoopPosition, const FVector2D& Scale2D);
+
 	/** Returns the length of the specified spline segment up to the parametric value given */
 	float GetSegmentLength(const int32 Index, const float Param, bool bClosedLoop = false, const FVector2D& Scale2D = FVector2D(1.0f)) const;
 
 	/** Returns total length along this spline */
 	float GetSplineLength() const;
-};
\ No newline at end of file
+
+	/** Get distance along the spline at the provided input key value */
+	float GetDistanceAlongSplineAtSplineInputKey(float InKey) const;
+
+	int32 GetNumSegments() const
+	{
+		return FMath::Max(Position.bIsLooped ? Position.Points.Num() : Position.Points.Num() - 1, 0);
+	}
+
+	/** Returns the Bezier control points of a segment. Curves loaded from before they were cached convert them from the tangents. */
+	void GetSegmentBezierPoints(int32 SegmentIndex, FVector2D OutPoints[4]) const;
+
+	/** Returns the tight bounds of a segment. Curves loaded from before they were cached compute them. */
+	FBox2D GetSegmentBounds(int32 SegmentIndex) const;
+
+	/**
+	 * Finds where this spline crosses another. Only pairs of segments whose bounds overlap, found by sweeping over the
+	 * bounds along X, are subdivided until both are flat enough to intersect as lines.
+	 * @param	OutIntersections	Receives the crossings in the order of this spline, with A being this spline and B the other
+	 */
+	void FindIntersections(const FSlateSplineCurves& Other, TArray<FSlateSplineIntersection>& OutIntersections) const;
+
+	/**
+	 * Finds where any two of the splines cross. Pairs of splines are only tested if their bounds overlap, found by sweeping over the bounds along X.
+	 * @param	OutIntersections	Receives the crossings with the indices of both curves, the lower index as A
+	 */
+	static void FindIntersections(TConstArrayView<const FSlateSplineCurves*> Curves, TArray<FSlateSplineIntersection>& OutIntersections);
+
+	/**
+	 * Returns whether any part of the spline is inside the rectangle. Only segments whose bounds overlap it, but are not inside it, are subdivided.
+	 * @param	OutInputKey		Receives an input key of the spline inside the rectangle
+	 */
+	bool OverlapsRect(const FBox2D& Rect, float& OutInputKey) const;
+
+	/** Finds the splines of which any part is inside the rectangle, such as a selection marquee. */
+	static void FindOverlappingRect(TConstArrayView<const FSlateSplineCurves*> Curves, const FBox2D& Rect, TArray<int32>& OutCurveIndices);
+
+	/**
+	 * Evaluates the location and rotation angle (in degrees) at each of the given distances along the spline.
+	 * Distances given in ascending order are resolved with a single walk over the reparam table instead of a search per distance.
+	 * @param	Distances				Distances along the spline
+	 * @param	OutLocations			Receives the location at each distance, must be as large as Distances
+	 * @param	OutRotationAngles		Receives the rotation angle at each distance, must be as large as Distances
+	 */
+	void GetLocationsAndRotationsAtDistances(TConstArrayView<float> Distances, TArrayView<FVector2D> OutLocations, TArrayView<float> OutRotationAngles) const;
+
+	/**
+	 * Finds the closest point on the spline to each of the given positions, in parallel. A single segment index is built for
+	 * the whole batch; callers querying the same curves every frame can keep an FSlateSplineSegmentIndex instead.
+	 * Output views are written in place and may be empty to skip them, others must be as large as Positions.
+	 * @param	OutSignedDistances		Receives the distance to the spline, positive on the right of the spline as it goes on, with Y pointing down
+	 */
+	void FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations, TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const;
+
+private:
+	/** Evaluates position and tangent of the segment starting at the given point index */
+	void EvalSegment(const int32 Index, const float Alpha, FVector2D& OutLocation, FVector2D& OutTangent) const;
+};
+
+/** Lets Slate widgets query curves owned by a UObject without keeping a pointer that could outlive it. */
+DECLARE_DELEGATE_RetVal(const FSlateSplineCurves*, FOnGetSplineCurves)
\ No newline at end of file
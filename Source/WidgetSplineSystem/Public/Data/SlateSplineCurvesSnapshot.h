@@ -0,0 +1,125 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplineCurves.h"
+
+#include <atomic>
+
+/**
+ * Immutable, reference-counted curves of a spline, safe to query from any thread without locks.
+ * Queries are in the local space of the spline widget, since converting to screen or viewport space needs its geometry.
+ */
+class WIDGETSPLINESYSTEM_API FSlateSplineCurvesSnapshot
+{
+public:
+	FSlateSplineCurvesSnapshot() = default;
+	explicit FSlateSplineCurvesSnapshot(const TSharedPtr<const FSlateSplineCurves>& InCurves)
+		: Curves(InCurves)
+	{}
+
+	bool IsValid() const
+	{
+		return Curves.IsValid();
+	}
+
+	/** Returns the curves, or empty curves if there are none yet. */
+	const FSlateSplineCurves& GetCurves() const;
+
+	/** Returns total length along this spline */
+	float GetSplineLength() const;
+
+	/** Get distance along the spline at the provided input key value */
+	float GetDistanceAlongSplineAtSplineInputKey(float InKey) const;
+
+	/** Get location along spline at the provided input key value */
+	FVector2D GetLocationAtSplineInputKey(float InKey) const;
+
+	/** Get tangent along spline at the provided input key value */
+	FVector2D GetTangentAtSplineInputKey(float InKey) const;
+
+	/** Get unit direction along spline at the provided input key value */
+	FVector2D GetDirectionAtSplineInputKey(float InKey) const;
+
+	/** Get rotation angle, in degrees, along spline at the provided input key value */
+	float GetRotationAngleAtSplineInputKey(float InKey) const;
+
+	/** Get the location at spline point */
+	FVector2D GetLocationAtSplinePoint(int32 PointIndex) const;
+
+	/** Get the direction at spline point */
+	FVector2D GetDirectionAtSplinePoint(int32 PointIndex) const;
+
+	/** Get the tangent at spline point. This fetches the Leave tangent of the point. */
+	FVector2D GetTangentAtSplinePoint(int32 PointIndex) const;
+
+	/** Given a distance along the length of this spline, return the corresponding input key at that point */
+	float GetInputKeyAtDistanceAlongSpline(float Distance) const;
+
+	/** Given a distance along the length of this spline, return the point in space where this puts you */
+	FVector2D GetLocationAtDistanceAlongSpline(float Distance) const;
+
+	/** Given a distance along the length of this spline, return a unit direction vector of the spline tangent there. */
+	FVector2D GetDirectionAtDistanceAlongSpline(float Distance) const;
+
+	/** Given a distance along the length of this spline, return the tangent vector of the spline there. */
+	FVector2D GetTangentAtDistanceAlongSpline(float Distance) const;
+
+	/** Given a distance along the length of this spline, return the rotation angle, in degrees, of the spline there. */
+	float GetRotationAngleAtDistanceAlongSpline(float Distance) const;
+
+	/** Finds the closest point on the spline to each position, in parallel. See FSlateSplineCurves::FindClosestPoints. */
+	void FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations, TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const;
+
+	const FInterpCurvePointVector2D& GetPositionPointSafe(int32 PointIndex) const;
+
+private:
+	TSharedPtr<const FSlateSplineCurves> Curves;
+};
+
+/**
+ * Publishes the latest curves of a spline widget. The game thread swaps new curves in,
+ * while any thread can take a snapshot that stays consistent however often they are swapped afterwards.
+ * Readers never lock: the published curves are exchanged atomically, and the ones swapped out are released once no reader can still be taking them.
+ */
+class WIDGETSPLINESYSTEM_API FSlateSplineCurvesPublisher
+{
+public:
+	FSlateSplineCurvesPublisher() = default;
+	~FSlateSplineCurvesPublisher();
+	UE_NONCOPYABLE(FSlateSplineCurvesPublisher);
+
+	/** Swaps in new curves. Only on the thread that owns the widget, the game thread once it is loaded. */
+	void Publish(const TSharedPtr<const FSlateSplineCurves>& InCurves);
+
+	/** Returns the published curves. Only on the thread that publishes them, which is the only one swapping them. */
+	const TSharedPtr<const FSlateSplineCurves>& GetPublished() const
+	{
+		return Curves;
+	}
+
+	/** Returns the published curves from any thread, without locking. */
+	FSlateSplineCurvesSnapshot GetSnapshot() const;
+
+private:
+	/** Immutable once published, readers only take a reference to the curves it holds. */
+	struct FPublishedCurves
+	{
+		TSharedPtr<const FSlateSplineCurves> Curves;
+	};
+
+	/** Releases the retired curves if no reader is taking a snapshot. */
+	void ReleaseRetired();
+
+	/** The published curves, for the publishing thread. */
+	TSharedPtr<const FSlateSplineCurves> Curves;
+
+	/** The published curves, for readers. */
+	std::atomic<FPublishedCurves*> Published{nullptr};
+
+	/** Readers between loading Published and taking their reference, which may still be reading a retired entry. */
+	mutable std::atomic<int32> NumActiveReaders{0};
+
+	/** Entries swapped out while readers were active. Only touched by the publishing thread. */
+	TArray<TUniquePtr<FPublishedCurves>> Retired;
+};
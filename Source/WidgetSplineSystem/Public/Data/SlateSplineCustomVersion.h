@@ -0,0 +1,29 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Guid.h"
+
+/** Versions of the native serialization of the spline structs. */
+struct WIDGETSPLINESYSTEM_API FSlateSplineCustomVersion
+{
+	enum Type
+	{
+		/** Splines were saved as tagged properties. */
+		BeforeCustomVersionWasAdded = 0,
+
+		/** Spline points are saved as contiguous blocks, optionally quantized. */
+		BulkPoints,
+
+		/** Spline widgets save their built curves after their tagged properties. */
+		SharedCurves,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+
+private:
+	FSlateSplineCustomVersion() {}
+};
@@ -12,10 +12,21 @@ struct WIDGETSPLINESYSTEM_API FSlateSplinePoint
 	FSlateSplinePoint() = default;
 	FSlateSplinePoint(const FVector2D InLocation, FVector2D InDirection) : Location(InLocation), Direction(InDirection)
 	{}
+	FSlateSplinePoint(const FVector2D InLocation, FVector2D InDirection, const float InWidth, const FLinearColor& InColor)
+		: Location(InLocation), Direction(InDirection), Width(InWidth), Color(InColor)
+	{}
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget")
 	FVector2D Location = FVector2D::ZeroVector;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget")
 	FVector2D Direction = FVector2D::ZeroVector;
+
+	/** Multiplier of the brush width at this point. Interpolated along the spline up to the next point. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget", meta=(ClampMin="0.0"))
+	float Width = 1.0f;
+
+	/** Multiplied with the brush tint at this point. Interpolated along the spline up to the next point. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget")
+	FLinearColor Color = FLinearColor::White;
 };
@@ -0,0 +1,103 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplineCurves.h"
+
+/**
+ * Spline curves flattened into a polyline, with a bounding volume hierarchy over its segments, so queries only visit the
+ * few segments near a position. Segments are ordered along the curve, so pairing neighbouring nodes keeps the boxes
+ * tight without sorting them. Immutable once built, so any number of threads can query it at once.
+ */
+class WIDGETSPLINESYSTEM_API FSlateSplineSegmentIndex
+{
+public:
+	/** Flattens the curves and rebuilds the hierarchy over them. */
+	void Build(const FSlateSplineCurves& Curves);
+
+	/**
+	 * Finds the closest point on the curve to a position.
+	 * @param	OutSignedDistance	Distance to the curve, positive on the right of the curve as it goes on, with Y pointing down
+	 * @return	Whether the index has any segment
+	 */
+	bool FindClosestPoint(const FVector2D& Position, FVector2D& OutLocation, float& OutInputKey, float& OutSignedDistance) const;
+
+	/**
+	 * Finds the closest point on the curve to each position, split across worker threads for large batches.
+	 * Output views are written in place and may be empty to skip them, others must be as long as Positions.
+	 */
+	void FindClosestPoints(TConstArrayView<FVector2D> Positions, TArrayView<FVector2D> OutLocations, TArrayView<float> OutInputKeys, TArrayView<float> OutSignedDistances) const;
+
+	/** Calls Visitor with the index of every segment whose bounds are within Radius of the position. */
+	template<typename VisitorType>
+	void ForEachSegmentNear(const FVector2D& Position, float Radius, VisitorType&& Visitor) const
+	{
+		if (Levels.Num() == 0)
+		{
+			return;
+		}
+
+		const float SquaredRadius = FMath::Square(Radius);
+
+		// Level and index of the nodes left to visit, starting from the root
+		TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+		Stack.Emplace(Levels.Num() - 1, 0);
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Node = Stack.Pop(false);
+			if (Levels[Node.Key][Node.Value].ComputeSquaredDistanceToPoint(Position) > SquaredRadius)
+			{
+				continue;
+			}
+
+			if (Node.Key > 0)
+			{
+				const int32 LastChild = FMath::Min(Node.Value * 2 + 2, Levels[Node.Key - 1].Num());
+				for (int32 ChildIndex = Node.Value * 2; ChildIndex < LastChild; ChildIndex++)
+				{
+					Stack.Emplace(Node.Key - 1, ChildIndex);
+				}
+				continue;
+			}
+
+			const int32 LastSegment = FMath::Min((Node.Value + 1) * LeafSize, GetNumSegments());
+			for (int32 SegmentIndex = Node.Value * LeafSize; SegmentIndex < LastSegment; SegmentIndex++)
+			{
+				Visitor(SegmentIndex);
+			}
+		}
+	}
+
+	int32 GetNumSegments() const
+	{
+		return FMath::Max(Locations.Num() - 1, 0);
+	}
+
+	/** Vertices of the flattened curve. Segment i runs from vertex i to vertex i + 1. */
+	const TArray<FVector2D>& GetLocations() const
+	{
+		return Locations;
+	}
+
+	/** Input key of the curve at each vertex. */
+	const TArray<float>& GetInputKeys() const
+	{
+		return InputKeys;
+	}
+
+private:
+	TArray<FVector2D> Locations;
+	TArray<float> InputKeys;
+
+	/** Whether the last vertex joins the first one, so the first and last segments meet there. */
+	bool bIsClosedLoop = false;
+
+	/** Segments in each leaf of the hierarchy. */
+	static constexpr int32 LeafSize = 8;
+
+	/**
+	 * Bounds of the nodes of each level of the hierarchy, from the leaves up to the root.
+	 * Leaf i holds segments [i * LeafSize, (i + 1) * LeafSize), and node i of a level holds nodes 2i and 2i + 1 of the level below.
+	 */
+	TArray<TArray<FBox2D>> Levels;
+};
@@ -0,0 +1,25 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SplineHitResult.generated.h"
+
+/** Where a position hit the stroke of a spline. */
+USTRUCT(BlueprintType)
+struct WIDGETSPLINESYSTEM_API FSplineHitResult
+{
+	GENERATED_BODY()
+
+	/** Closest point on the middle of the stroke, in the local space of the spline widget. */
+	UPROPERTY(BlueprintReadOnly, Category="Spline Widget")
+	FVector2D Location = FVector2D::ZeroVector;
+
+	/** Distance from the position to the middle of the stroke. */
+	UPROPERTY(BlueprintReadOnly, Category="Spline Widget")
+	float Distance = 0.0f;
+
+	/** Input key of the spline at Location. */
+	UPROPERTY(BlueprintReadOnly, Category="Spline Widget")
+	float InputKey = 0.0f;
+};
@@ -0,0 +1,76 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplinePoint.h"
+
+/**
+ * Fits a sketched stroke with as few spline points as possible while it is being drawn.
+ * Samples are fitted with cubic segments by least squares, and a segment is closed as soon as a new sample can no longer
+ * be fitted within the error, so each sample only costs as much as the samples of the segment still open.
+ */
+class WIDGETSPLINESYSTEM_API FSplineStrokeFitter
+{
+public:
+	/**
+	 * @param	InMaxError				Maximum distance between the fitted spline and any sample
+	 * @param	InMinSampleDistance		Samples closer than this to the previous one are skipped
+	 */
+	explicit FSplineStrokeFitter(float InMaxError = 2.0f, float InMinSampleDistance = 2.0f);
+
+	/** Discards the current stroke and starts a new one. */
+	void Reset();
+	void Reset(float InMaxError, float InMinSampleDistance);
+
+	void AddSample(const FVector2D& Location);
+
+	/** Closes the segment still open. Samples added afterwards continue the stroke. */
+	void Finish();
+
+	/** Returns the points fitted so far, including the end of the segment still open. */
+	void GetPoints(TArray<FSlateSplinePoint>& OutPoints) const;
+
+	int32 GetNumSamples() const
+	{
+		return NumSamples;
+	}
+
+private:
+	struct FCubic
+	{
+		FVector2D P0;
+		FVector2D P1;
+		FVector2D P2;
+		FVector2D P3;
+
+		FVector2D Evaluate(double T) const;
+	};
+
+	/** Fits a single cubic through the open samples. Returns the largest squared distance of a sample to it. */
+	double FitOpenSamples(FCubic& OutCubic);
+	void GenerateCubic(FCubic& OutCubic) const;
+	double ComputeMaxErrorSquared(const FCubic& Cubic) const;
+	void Reparameterize(const FCubic& Cubic);
+	void CommitSegment(const FCubic& Cubic);
+
+	double MaxErrorSquared;
+	double MinSampleDistance;
+
+	/** Closed segments, as spline points. */
+	TArray<FSlateSplinePoint> Points;
+
+	/** Samples of the open segment, starting at the end of the last closed one, their chord lengths and parameters. */
+	TArray<FVector2D> Samples;
+	TArray<double> SampleLengths;
+	TArray<double> Params;
+
+	/** Best fit of the open samples. */
+	FCubic OpenCubic;
+	bool bHasOpenCubic = false;
+
+	/** Offset of the first control point from the start of the open segment, shared with the end of the previous one. */
+	FVector2D StartHandle = FVector2D::ZeroVector;
+	bool bHasStartHandle = false;
+
+	int32 NumSamples = 0;
+};
@@ -4,22 +4,134 @@
 
 #include "Data/SlatePaintContext.h"
 #include "Data/SlateSpline.h"
+#include "Data/SlateSplineCurves.h"
+#include "Data/SplineHitResult.h"
+#include "Slate/SplineBrushResource.h"
+#include "Slate/SplineHitTester.h"
+#include "Slate/SplineTessellation.h"
+
+/** Fired with where a position hit the stroke of a spline. */
+DECLARE_DELEGATE_OneParam(FOnSplineHit, const FSplineHitResult&)
 
 class WIDGETSPLINESYSTEM_API SSpline : public SLeafWidget
 {
 protected:
 	TAttribute<FSlateSpline> Spline;
 
+	/** Spline read in place of Spline while bound, so a widget that owns the spline is not copied on every paint and hit test. */
+	FOnGetSpline OnGetSpline;
+
+	/**
+	 * Changes whenever the spline data changes, widths and colors included. While set, the brush geometry and the stroke hit testing
+	 * are only rebuilt when it does.
+	 */
+	TAttribute<uint32> SplineVersion;
+
+	/** Curves built from the spline, if any. Their bounds size the widget without visiting every point. */
+	FOnGetSplineCurves OnGetSplineCurves;
+
+	float UVOffset = 0.0f;
+	float UVScrollSpeed = 0.0f;
+
+	/** Fills the inside of closed loops, under the stroke. Fully transparent draws no fill. */
+	FLinearColor FillColor = FLinearColor::Transparent;
+
+	/** Whether a polyline through the points is drawn while the brush geometry waits for the build scheduler. */
+	bool bDrawPolylineWhileBuilding = true;
+
+	/** Whether the mouse is tested against the stroke, so only clicks and hovers on the stroke itself are handled. */
+	bool bHitTestStroke = false;
+
+	/** Slate units beyond the edge of the stroke that still hit it. */
+	float HitTolerance = 0.0f;
+
+	FOnSplineHit OnClicked;
+	FOnSplineHit OnHovered;
+	FSimpleDelegate OnUnhovered;
+
 public:
-	SLATE_BEGIN_ARGS(SSpline) : _Spline() {}
+	SLATE_BEGIN_ARGS(SSpline)
+		: _Spline()
+		, _OnGetSpline()
+		, _SplineVersion()
+		, _OnGetSplineCurves()
+		, _UVOffset(0.0f)
+		, _UVScrollSpeed(0.0f)
+		, _FillColor(FLinearColor::Transparent)
+		, _bDrawPolylineWhileBuilding(true)
+		, _bHitTestStroke(false)
+		, _HitTolerance(0.0f)
+		{}
 		SLATE_ATTRIBUTE(FSlateSpline, Spline);
+		SLATE_EVENT(FOnGetSpline, OnGetSpline);
+		SLATE_ATTRIBUTE(uint32, SplineVersion);
+		SLATE_EVENT(FOnGetSplineCurves, OnGetSplineCurves);
+		SLATE_ARGUMENT(float, UVOffset);
+		SLATE_ARGUMENT(float, UVScrollSpeed);
+		SLATE_ARGUMENT(FLinearColor, FillColor);
+		SLATE_ARGUMENT(bool, bDrawPolylineWhileBuilding);
+		SLATE_ARGUMENT(bool, bHitTestStroke);
+		SLATE_ARGUMENT(float, HitTolerance);
+		/** Fired when the stroke is pressed and released with the left mouse button. Only while the stroke is hit tested. */
+		SLATE_EVENT(FOnSplineHit, OnClicked);
+		/** Fired when the mouse moves onto the stroke. Only while the stroke is hit tested. */
+		SLATE_EVENT(FOnSplineHit, OnHovered);
+		SLATE_EVENT(FSimpleDelegate, OnUnhovered);
 	SLATE_END_ARGS()
-	
+
 	void Construct(const FArguments& InArguments);
 	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 
+	/**
+	 * Offsets the V texture coordinate of the brush geometry, scrolling the brush along the spline.
+	 * @param	InUVOffset			Constant offset added to V
+	 * @param	InUVScrollSpeed		V units per second added on top of the offset
+	 */
+	void SetUVScroll(float InUVOffset, float InUVScrollSpeed);
+
+	void SetFillColor(const FLinearColor& InFillColor);
+
+	void SetHitTestStroke(bool bInHitTestStroke, float InHitTolerance);
+
+	/**
+	 * Tests a position in local space against the stroke, as thick as the brush and point widths make it, whether or not mouse input is hit tested.
+	 * Costs a lookup in the segment hierarchy, rebuilt when the spline version or brush width changes, or on every test without a version. Curves still queued are not hit.
+	 * Bind OnGetSpline when testing on every mouse move, a spline only bound to Spline is copied on every test.
+	 * @return	Whether the position is on the stroke or within HitTolerance of its edge
+	 */
+	bool HitTestStroke(const FVector2D& LocalPosition, FSplineHitResult& OutHit) const;
+
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent) override;
+
 protected:
+	virtual bool ComputeVolatility() const override;
+
+	/** Returns the spline from OnGetSpline if it is bound and returns one, otherwise from Spline. */
+	const FSlateSpline& GetSpline() const;
+
 	virtual void PaintSplineSimple(const FSlatePaintContext& InPaintContext) const;
 	virtual void PaintSplineBrush(const FSlatePaintContext& InPaintContext) const;
+
+	/** Cheap stand-in for the brush geometry: straight lines through the points. */
+	void PaintSplinePolyline(const FSlatePaintContext& InPaintContext) const;
+
+	float GetUVOffsetAtTime(double InCurrentTime) const;
+
+private:
+	/** Brush geometry in local space, rebuilt only when the spline, brush size, tint or fill changes. Built by the build scheduler if it is not shared yet. */
+	mutable FSplineTessellation Tessellation;
+
+	/** Resource the brush geometry is drawn with, resolved again only when the brush resource changes. */
+	mutable FSplineBrushResource BrushResource;
+
+	/** Flattened stroke the mouse is tested against, in local space. Built on the first test after the spline changes. */
+	mutable FSplineHitTester HitTester;
+
+	bool bIsStrokeHovered = false;
+	bool bIsStrokePressed = false;
 };
@@ -0,0 +1,88 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplineCurves.h"
+#include "Layout/Children.h"
+#include "Widgets/SPanel.h"
+
+/** Arranges its children along a spline during layout. */
+class WIDGETSPLINESYSTEM_API SSplineRailPanel : public SPanel
+{
+public:
+	class WIDGETSPLINESYSTEM_API FSlot : public TSlotBase<FSlot>
+	{
+	public:
+		SLATE_SLOT_BEGIN_ARGS(FSlot, TSlotBase<FSlot>)
+			SLATE_ARGUMENT(TOptional<float>, Position)
+			SLATE_ARGUMENT(TOptional<bool>, bIsPositionNormalized)
+			SLATE_ARGUMENT(TOptional<FVector2D>, Alignment)
+			SLATE_ARGUMENT(TOptional<bool>, bOrientToTangent)
+		SLATE_SLOT_END_ARGS()
+
+		void Construct(const FChildren& SlotOwner, FSlotArguments&& InArgs);
+
+		/** Sets the distance along the spline, or the fraction of its length if the position is normalized. */
+		void SetPosition(float InPosition);
+		float GetPosition() const { return Position; }
+
+		void SetIsPositionNormalized(bool bInIsPositionNormalized);
+		bool IsPositionNormalized() const { return bIsPositionNormalized; }
+
+		/** Sets the point of the child, relative to its size, that is placed on the spline. */
+		void SetAlignment(const FVector2D& InAlignment);
+		FVector2D GetAlignment() const { return Alignment; }
+
+		void SetOrientToTangent(bool bInOrientToTangent);
+		bool ShouldOrientToTangent() const { return bOrientToTangent; }
+
+	private:
+		friend SSplineRailPanel;
+
+		void InvalidatePlacement();
+
+		float Position = 0.0f;
+		bool bIsPositionNormalized = false;
+		FVector2D Alignment = FVector2D(0.5f, 0.5f);
+		bool bOrientToTangent = false;
+
+		/** Placement on the spline, only recomputed when the curve or the position parameters change. */
+		mutable FVector2D CachedLocation = FVector2D::ZeroVector;
+		mutable float CachedRotationAngle = 0.0f;
+		mutable bool bIsPlacementDirty = true;
+	};
+
+	static FSlot::FSlotArguments Slot();
+
+	using FScopedWidgetSlotArguments = TPanelChildren<FSlot>::FScopedWidgetSlotArguments;
+	FScopedWidgetSlotArguments AddSlot();
+	int32 RemoveSlot(const TSharedRef<SWidget>& SlotWidget);
+	void ClearChildren();
+
+	SLATE_BEGIN_ARGS(SSplineRailPanel)
+		: _OnGetSplineCurves()
+		{
+			_Visibility = EVisibility::SelfHitTestInvisible;
+		}
+		SLATE_SLOT_ARGUMENT(FSlot, Slots)
+		SLATE_EVENT(FOnGetSplineCurves, OnGetSplineCurves)
+	SLATE_END_ARGS()
+
+	SSplineRailPanel();
+	void Construct(const FArguments& InArgs);
+
+	virtual void OnArrangeChildren(const FGeometry& AllottedGeometry, FArrangedChildren& ArrangedChildren) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	virtual FChildren* GetChildren() override;
+
+protected:
+	/** Places every slot whose position changed, or all of them if the curve changed, with one batched evaluation. */
+	void UpdatePlacements() const;
+
+	FOnGetSplineCurves OnGetSplineCurves;
+	TPanelChildren<FSlot> Children;
+
+private:
+	mutable uint32 CachedCurvesVersion = 0;
+	mutable bool bHasCachedCurvesVersion = false;
+};
@@ -0,0 +1,82 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Slate/SSpline.h"
+#include "Fonts/ShapedTextFwd.h"
+
+/** Draws shaped text along a spline, optionally on top of the spline itself. */
+class WIDGETSPLINESYSTEM_API SSplineText : public SSpline
+{
+public:
+	SLATE_BEGIN_ARGS(SSplineText)
+		: _Spline()
+		, _OnGetSpline()
+		, _SplineVersion()
+		, _OnGetSplineCurves()
+		, _Text()
+		, _Font()
+		, _ColorAndOpacity(FLinearColor::White)
+		, _StartDistance(0.0f)
+		, _BaselineOffset(0.0f)
+		, _bDrawSpline(true)
+		, _bDrawPolylineWhileBuilding(true)
+		, _bHitTestStroke(false)
+		, _HitTolerance(0.0f)
+		{}
+		SLATE_ATTRIBUTE(FSlateSpline, Spline);
+		SLATE_EVENT(FOnGetSpline, OnGetSpline);
+		SLATE_ATTRIBUTE(uint32, SplineVersion);
+		SLATE_EVENT(FOnGetSplineCurves, OnGetSplineCurves);
+		SLATE_ARGUMENT(FText, Text);
+		SLATE_ARGUMENT(FSlateFontInfo, Font);
+		SLATE_ARGUMENT(FSlateColor, ColorAndOpacity);
+		SLATE_ARGUMENT(float, StartDistance);
+		SLATE_ARGUMENT(float, BaselineOffset);
+		SLATE_ARGUMENT(bool, bDrawSpline);
+		SLATE_ARGUMENT(bool, bDrawPolylineWhileBuilding);
+		SLATE_ARGUMENT(bool, bHitTestStroke);
+		SLATE_ARGUMENT(float, HitTolerance);
+		SLATE_EVENT(FOnSplineHit, OnClicked);
+		SLATE_EVENT(FOnSplineHit, OnHovered);
+		SLATE_EVENT(FSimpleDelegate, OnUnhovered);
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArguments);
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	void SetText(const FText& InText);
+	void SetFont(const FSlateFontInfo& InFont);
+	void SetColorAndOpacity(const FSlateColor& InColorAndOpacity);
+	void SetStartDistance(float InStartDistance);
+	void SetBaselineOffset(float InBaselineOffset);
+	void SetDrawSpline(bool bInDrawSpline);
+
+protected:
+	/** Reshapes the text and places its glyphs if the text, font, scale or curve changed since they were placed. */
+	void UpdateGlyphPlacements(const FSlateSplineCurves& Curves, float FontScale) const;
+
+	FText Text;
+	FSlateFontInfo Font;
+	FSlateColor ColorAndOpacity;
+	float StartDistance = 0.0f;
+	float BaselineOffset = 0.0f;
+	bool bDrawSpline = true;
+
+private:
+	/** A cluster of glyphs that is placed as a whole, so ligatures and combining marks stay together. */
+	struct FGlyphPlacement
+	{
+		FShapedGlyphSequencePtr Glyphs;
+		FVector2D Location = FVector2D::ZeroVector;
+		float RotationAngle = 0.0f;
+		float Advance = 0.0f;
+	};
+
+	mutable TArray<FGlyphPlacement> CachedGlyphs;
+	mutable float CachedLineHeight = 0.0f;
+	mutable float CachedBaseline = 0.0f;
+	mutable float CachedFontScale = 0.0f;
+	mutable uint32 CachedCurvesVersion = 0;
+	mutable bool bAreGlyphsDirty = true;
+};
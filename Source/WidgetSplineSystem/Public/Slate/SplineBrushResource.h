@@ -0,0 +1,80 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/SlateResourceHandle.h"
+#include "Styling/SlateBrush.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * Render resource handles of spline brushes, resolved once per resource object and image size and shared by every spline drawn with them.
+ * The size is part of the key like it is of the renderer's own material resources, which it creates per material and size.
+ * Only used on the game thread, like the Slate renderer it asks.
+ */
+class WIDGETSPLINESYSTEM_API FSplineBrushResourceCache
+{
+public:
+	static FSplineBrushResourceCache& Get();
+
+	/**
+	 * Returns the handle of the brush resource, asking the renderer only if no brush with the same resource object and image size was drawn yet,
+	 * or its resource was released since.
+	 */
+	FSlateResourceHandle FindOrAddHandle(const FSlateBrush& Brush);
+
+	/** Returns the number of resource objects and sizes with a cached handle, released or not. */
+	int32 GetNumHandles() const
+	{
+		return Handles.Num();
+	}
+
+private:
+	struct FKey
+	{
+		TObjectKey<UObject> ResourceObject;
+		FVector2f ImageSize = FVector2f::ZeroVector;
+
+		bool operator==(const FKey& Other) const
+		{
+			return ResourceObject == Other.ResourceObject && ImageSize == Other.ImageSize;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.ResourceObject), GetTypeHash(Key.ImageSize));
+		}
+	};
+
+	TMap<FKey, FSlateResourceHandle> Handles;
+
+	/** Entries past which released resources are purged. Grows with the live entries, so purging stays amortized. */
+	int32 PurgeThreshold = 64;
+};
+
+/**
+ * Resource the brush geometry of a spline is drawn with, resolved again only when the brush resource object or image size changes.
+ * Brushes without a valid resource object, null included, are drawn with the built-in spline element instead.
+ */
+class WIDGETSPLINESYSTEM_API FSplineBrushResource
+{
+public:
+	/**
+	 * Resolves the resource of the brush if it changed since the last update.
+	 * @return	Whether the brush has a resource to draw the brush geometry with
+	 */
+	bool Update(const FSlateBrush& Brush);
+
+	const FSlateResourceHandle& GetHandle() const
+	{
+		return Handle;
+	}
+
+private:
+	TWeakObjectPtr<const UObject> ResourceObject;
+	FVector2f ImageSize = FVector2f::ZeroVector;
+	FSlateResourceHandle Handle;
+	bool bHasResource = false;
+	bool bIsValid = false;
+};
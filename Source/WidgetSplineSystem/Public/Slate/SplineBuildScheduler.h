@@ -0,0 +1,83 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Data/SlateSpline.h"
+
+/** A build queued with the spline build scheduler. Releasing the last reference to it cancels the build. */
+class WIDGETSPLINESYSTEM_API FSplineBuildRequest
+{
+public:
+	explicit FSplineBuildRequest(TFunction<void()>&& InBuild)
+		: Build(MoveTemp(InBuild))
+	{}
+
+	bool IsPending() const
+	{
+		return Build.IsSet();
+	}
+
+	/** Runs the build now if it has not run yet, for callers that cannot wait for it. */
+	void Flush();
+
+private:
+	TFunction<void()> Build;
+};
+
+/**
+ * Spreads the spline builds of widgets over several frames, so opening a screen with many splines does not spike.
+ * Builds run on the game thread in the order they were queued, within the per-frame budget set by Slate.SplineBuildBudgetMs.
+ * Curves of splines whose data changed are instead batched and built in parallel before Slate ticks next.
+ */
+class WIDGETSPLINESYSTEM_API FSplineBuildScheduler
+{
+public:
+	static FSplineBuildScheduler& Get();
+
+	/**
+	 * Queues a build to run on a later frame. Without a budget, the build runs right away instead.
+	 * @return	The queued build, cancelled when the last reference to it is released
+	 */
+	TSharedRef<FSplineBuildRequest> Enqueue(TFunction<void()>&& Build);
+
+	/**
+	 * Queues a build of the curves of a spline with every other spline queued this frame. Right before Slate ticks,
+	 * their curves are built into the geometry registry in parallel, then each Build runs on the game thread and finds them there.
+	 * Without a budget, or without Slate, the build runs right away instead.
+	 * @return	The queued build, cancelled when the last reference to it is released
+	 */
+	TSharedRef<FSplineBuildRequest> EnqueueCurves(const FSlateSpline& Spline, TFunction<void()>&& Build);
+
+	/** Returns whether builds are spread over frames. If not, queued builds run right away. */
+	bool IsTimeSliced() const;
+
+	int32 GetNumPending() const;
+
+	/** Removes the ticker and the Slate pre tick delegate, and drops the queued builds. Called when the module shuts down. */
+	void Shutdown();
+
+private:
+	bool Tick(float DeltaTime);
+	void BuildCurvesBatch(float DeltaTime);
+
+	/** Queued builds, from QueueHead on. Cancelled builds are skipped when reached. */
+	TArray<TWeakPtr<FSplineBuildRequest>> Queue;
+	int32 QueueHead = 0;
+
+	/** The ticker is only registered while builds are queued, it removes itself once the queue drains. */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	struct FBatchedCurves
+	{
+		TWeakPtr<FSplineBuildRequest> Request;
+
+		/** Only what the curves are built from, without the brush. */
+		FSlateSpline Spline;
+	};
+
+	/** Curves queued since Slate last ticked. */
+	TArray<FBatchedCurves> CurvesBatch;
+	FDelegateHandle PreTickHandle;
+};
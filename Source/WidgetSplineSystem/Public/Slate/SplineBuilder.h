@@ -11,10 +11,27 @@
 struct WIDGETSPLINESYSTEM_API FSplineBuilder
 {
 	FSplineBuilder(const FVector2D& InSize, const FSlatePaintContext& PaintContext);
+	FSplineBuilder(const FVector2D& InSize, const FSlateRenderTransform& InRenderTransform, const FColor InTintColor);
 
 	void BuildBezierGeometry(FSlateSplinePoint SegmentStart, FSlateSplinePoint SegmentEnd, const bool bIsLinear);
 	void Finish(const bool bCloseLoop);
 
+	/**
+	 * Fills the closed outline built so far, once Finish was called. The fill is moved to the start of the vertex and index arrays, so it is drawn
+	 * under the stroke in the same batch. Outlines crossing themselves cannot be ear clipped and are filled by the even-odd rule instead.
+	 */
+	void BuildFill(const FColor FillColor);
+
+	int32 GetNumFillVertices() const
+	{
+		return NumFillVertices;
+	}
+
+	int32 GetNumFillIndices() const
+	{
+		return NumFillIndices;
+	}
+
 	TArray<FSlateVertex>& GetVertexArray()
 	{
 		return Vertices;
@@ -26,7 +43,17 @@ struct WIDGETSPLINESYSTEM_API FSplineBuilder
 	}
 	
 private:
-	void AppendPoint(const FVector2D NewPoint);
+	void AppendPoint(const FVector2D NewPoint, const float NewHalfThickness, const FColor NewColor);
+
+	float GetHalfLineThickness(const float Width) const
+	{
+		return HalfBaseThickness + HalfBrushWidth * Width;
+	}
+
+	FColor GetPointColor(const FLinearColor& PointColor) const
+	{
+		return PointColor == FLinearColor::White ? SingleColor : (LinearTintColor * PointColor).ToFColorSRGB();
+	}
 
 
 	/**
@@ -75,21 +102,47 @@ private:
 	static void deCasteljauSplit(const FVector2D P0, const FVector2D P1, const FVector2D P2, const FVector2D P3, FVector2D OutCurveParams[7]);
 
 	void Subdivide(const FVector2D P0, const FVector2D P1, const FVector2D P2, const FVector2D P3, float MaxBiasTimesTwo = 2.0f);
+
+	/**
+	 * Ear clips a simple polygon into triangles, indexing its points.
+	 * @return	False if no ear is left to clip, which happens when the polygon crosses itself
+	 */
+	static bool TriangulatePolygon(TConstArrayView<FVector2D> Polygon, TArray<int32>& OutIndices);
+
+	/**
+	 * Triangulates the inside of any polygon by the even-odd rule, as SVG and canvas fill with "evenodd": areas the outline wraps an odd
+	 * number of times are filled. The polygon is cut into trapezoids between the heights of its points and of its own crossings.
+	 * @param	OutPoints	Receives the corners of the trapezoids, which OutIndices index
+	 * @return	False if the polygon has no area
+	 */
+	static bool TriangulateEvenOdd(TConstArrayView<FVector2D> Polygon, TArray<FVector2D>& OutPoints, TArray<int32>& OutIndices);
 	
 private:
-	const FSlateRenderTransform& RenderTransform;
+	const FSlateRenderTransform RenderTransform;
 	const FColor SingleColor;
+	const FLinearColor LinearTintColor;
 
 	const FVector2f TextureCoord2;
 	const float CoordScaleV;
 	
 	FVector2D LastPointAdded[2];
+	float LastHalfThickness[2];
+	FColor LastColor[2];
 	FVector2D LastNormal;
-	float HalfLineThickness;
+	float HalfBaseThickness;
+	float HalfBrushWidth;
 	int32 NumPointsAdded = 0;
 	float CurrentLength = 0.0f;
 	float CurrentCoordV = 0.0f;
 
+	/** Flattened points of the segment being built, before width and color are interpolated along them. */
+	TArray<FVector2D> SegmentPoints;
+
+	/** Every point added to the middle of the stroke, the outline filled by BuildFill. */
+	TArray<FVector2D> OutlinePoints;
+	int32 NumFillVertices = 0;
+	int32 NumFillIndices = 0;
+
 	TArray<FSlateVertex> Vertices;
 	TArray<SlateIndex> Indices;
 };
\ No newline at end of file
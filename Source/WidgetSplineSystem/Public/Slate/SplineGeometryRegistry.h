@@ -0,0 +1,67 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplineCurves.h"
+#include "Slate/SplineTessellation.h"
+
+/**
+ * Shares immutable curves and brush geometry between widgets with identical spline data, keyed by a 64 bit hash of that data.
+ * A hit is compared against the data before it is shared, so colliding hashes never hand out another spline. Entries are reference counted and released with the last widget holding them. Entries are never modified:
+ * a widget whose spline changes looks up or builds another entry, so memory and build time scale with unique splines.
+ */
+class WIDGETSPLINESYSTEM_API FSplineGeometryRegistry
+{
+public:
+	static FSplineGeometryRegistry& Get();
+
+	/** Returns the curves built from the spline data with the default parameters, building them if no widget holds them yet. */
+	TSharedRef<const FSlateSplineCurves> FindOrAddCurves(const FSlateSpline& Spline);
+
+	/** Returns the curves built from the spline data if a widget already holds them, without building them. */
+	TSharedPtr<const FSlateSplineCurves> FindCurves(const FSlateSpline& Spline) const;
+
+	/** Shares curves that were built or loaded elsewhere, returning the entry already holding them if there is one. */
+	TSharedRef<const FSlateSplineCurves> AddCurves(FSlateSplineCurves&& Curves);
+
+	/** Returns the brush geometry of the spline with the given tint and fill, building it if no widget holds it yet. */
+	TSharedRef<const FSplineGeometry> FindOrAddGeometry(const FSlateSpline& Spline, FColor TintColor, FColor FillColor = FColor::Transparent);
+
+	/** Returns the brush geometry of the spline with the given tint and fill if a widget already holds it, without building it. */
+	TSharedPtr<const FSplineGeometry> FindGeometry(const FSlateSpline& Spline, FColor TintColor, FColor FillColor = FColor::Transparent) const;
+
+	/**
+	 * Saves or loads shared curves as part of the widget owning them. Loaded curves are shared right away,
+	 * so widgets loaded from a saved or cooked package neither rebuild nor duplicate them.
+	 */
+	static void SerializeCurves(FArchive& Ar, TSharedPtr<const FSlateSplineCurves>& Curves);
+
+	/** Returns the number of entries still held by a widget. */
+	int32 GetNumCurves() const;
+	int32 GetNumGeometries() const;
+
+private:
+	template<typename ValueType>
+	struct TEntryMap
+	{
+		TMap<uint64, TWeakPtr<const ValueType>> Entries;
+
+		/** Expired entries are purged once the map grows past this, so lookups never pay for them. */
+		int32 PurgeThreshold = 64;
+
+		/** Returns the entry of the key if it holds the data IsMatch looks for. An entry of other data under the same key is a miss. */
+		TSharedPtr<const ValueType> Find(uint64 Key, TFunctionRef<bool(const ValueType&)> IsMatch) const
+		{
+			const TSharedPtr<const ValueType> Entry = Entries.FindRef(Key).Pin();
+			return Entry.IsValid() && IsMatch(*Entry) ? Entry : TSharedPtr<const ValueType>();
+		}
+
+		/** Adds the value, unless a matching one was added first. An entry of other data under the same key is replaced, its holders keep it. */
+		TSharedRef<const ValueType> Add(uint64 Key, const TSharedRef<const ValueType>& Value, TFunctionRef<bool(const ValueType&)> IsMatch);
+		int32 GetNumAlive() const;
+	};
+
+	TEntryMap<FSlateSplineCurves> CurveEntries;
+	TEntryMap<FSplineGeometry> GeometryEntries;
+	mutable FCriticalSection CriticalSection;
+};
@@ -0,0 +1,43 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSpline.h"
+#include "Data/SlateSplineCurves.h"
+#include "Data/SlateSplineSegmentIndex.h"
+#include "Data/SplineHitResult.h"
+
+/**
+ * Tests positions against the stroke of a spline, as thick as its brush and point widths make it.
+ * The curve is flattened once into a segment index, so a test only visits the few segments near the position.
+ */
+class WIDGETSPLINESYSTEM_API FSplineHitTester
+{
+public:
+	/**
+	 * Flattens the curves and rebuilds the index over them.
+	 * @param	SplineVersion	Changes whenever the spline data changes, widths included, such as USplineWidget::GetSplineVersion.
+	 *							Not the version of the curves, which widgets whose points only differ in width share. If unset, IsBuiltFor never holds.
+	 */
+	void Build(const FSlateSplineCurves& Curves, const FSlateSpline& Spline, const TOptional<uint32>& SplineVersion);
+
+	/** Returns whether the tester was built for this version of the spline and this brush width. */
+	bool IsBuiltFor(const TOptional<uint32>& InSplineVersion, float InBrushWidth) const;
+
+	/**
+	 * Finds the closest point on the middle of the stroke, if the position is on the stroke or within Tolerance of its edge.
+	 * @return	Whether the stroke was hit
+	 */
+	bool HitTest(const FVector2D& Position, float Tolerance, FSplineHitResult& OutHit) const;
+
+private:
+	FSlateSplineSegmentIndex SegmentIndex;
+
+	/** Half the thickness of the stroke at each vertex of the index, and the largest of them. */
+	TArray<float> HalfThicknesses;
+	float MaxHalfThickness = 0.0f;
+
+	uint32 SplineVersion = 0;
+	float BrushWidth = 0.0f;
+	bool bIsValid = false;
+};
@@ -0,0 +1,114 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlatePaintContext.h"
+#include "Data/SlateSpline.h"
+
+class FSplineBuildRequest;
+struct FSplineTessellationJob;
+
+/** Brush geometry of a spline in the space of its points. Immutable once built, so widgets drawing the same spline share it. */
+struct FSplineGeometry
+{
+	TArray<FSlateVertex> Vertices;
+	TArray<SlateIndex> Indices;
+
+	/** Fill of a closed loop, the first vertices and indices of the arrays, so it is drawn under the stroke. */
+	int32 NumFillVertices = 0;
+	int32 NumFillIndices = 0;
+
+	/** What the geometry was built from, so registry entries whose hashes collide are told apart. */
+	TArray<FSlateSplinePoint> SourcePoints;
+	bool bIsLinear = false;
+	bool bIsClosedLoop = false;
+	FVector2D BrushSize = FVector2D::ZeroVector;
+	FColor TintColor;
+	FColor FillColor;
+
+	/** Returns whether the geometry was built from exactly this spline data, brush size, tint and fill. */
+	bool IsBuiltFrom(const FSlateSpline& Spline, const FColor InTintColor, const FColor InFillColor) const;
+};
+
+/**
+ * Retained brush geometry of a spline, built in the space of its points.
+ * Painting only transforms a copy of the cached vertices, so moving or zooming the spline does not subdivide it again.
+ */
+class WIDGETSPLINESYSTEM_API FSplineTessellation
+{
+public:
+	~FSplineTessellation();
+
+	/**
+	 * Looks the geometry up again if the spline, brush size, tint or fill changed since it was built.
+	 * Splines already drawn by another widget share its geometry instead of building their own.
+	 * @param	SplineVersion	Changes whenever the spline data changes. If unset, the geometry is rebuilt on every call.
+	 * @param	FillColor		Fills closed loops, unless fully transparent
+	 */
+	void Update(const FSlateSpline& Spline, const TOptional<uint32>& SplineVersion, const FColor TintColor, const FColor FillColor = FColor::Transparent);
+
+	/**
+	 * Like Update, but geometry that no widget shares yet is built on a later frame: by a worker thread for splines with
+	 * at least Slate.SplineAsyncTessellationMinPoints points, by the spline build scheduler otherwise.
+	 * The last geometry built keeps being drawn until the new one is swapped in. Splines without a version are built
+	 * right away, since there is no telling when a queued build would be stale.
+	 * @param	OnBuilt		Called on the game thread once queued geometry is swapped in, to repaint with it
+	 * @return	Whether there is geometry to paint, up to date or not
+	 */
+	bool UpdateDeferred(const FSlateSpline& Spline, const TOptional<uint32>& SplineVersion, const FColor TintColor, const FColor FillColor, TFunction<void()>&& OnBuilt);
+
+	/** Forces the next update to rebuild the geometry. */
+	void Invalidate();
+
+	/**
+	 * Draws the cached geometry with the resource of the spline brush.
+	 * @param	ResourceHandle	Handle of the brush resource, resolved once by FSplineBrushResource instead of on every paint
+	 * @param	SplineToRender	Maps the space of the spline points to render space
+	 * @param	UVOffset		Added to the V texture coordinate of every vertex
+	 */
+	void PaintBrush(const FSlatePaintContext& PaintContext, const FSlateResourceHandle& ResourceHandle, const FSlateRenderTransform& SplineToRender, float UVOffset);
+
+	/** Draws only the fill of the cached geometry, untextured, for brushes without a resource. */
+	void PaintFill(const FSlatePaintContext& PaintContext, const FSlateRenderTransform& SplineToRender);
+
+	/** Draws the spline with the built-in spline element, for brushes without a resource. */
+	static void PaintSimple(const FSlatePaintContext& PaintContext, const FSlateSpline& Spline, const FPaintGeometry& SplinePaintGeometry);
+
+	/** Subdivides the spline into brush geometry, with the fill first if the spline is a closed loop and InFillColor is not fully transparent. */
+	static TSharedRef<const FSplineGeometry> BuildGeometry(const FSlateSpline& Spline, const FColor TintColor, const FColor InFillColor);
+
+	/** Returns the fill color the geometry of the spline is built with, transparent if it has no fill. */
+	static FColor GetEffectiveFillColor(const FSlateSpline& Spline, const FColor InFillColor);
+
+	const TArray<FSlateVertex>& GetVertices() const;
+	const TArray<SlateIndex>& GetIndices() const;
+
+private:
+	bool IsUpToDate(uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor) const;
+	void SetGeometry(const TSharedRef<const FSplineGeometry>& InGeometry, uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor);
+
+	/** Hands the build to a worker thread, with a copy of the points instead of the spline. */
+	void LaunchJob(const FSlateSpline& Spline, uint32 SplineVersion, const FVector2D& InBrushSize, const FColor InTintColor, const FColor InFillColor, TFunction<void()>&& OnBuilt);
+	void CancelPending();
+
+	TSharedPtr<const FSplineGeometry> Geometry;
+	uint32 Version = 0;
+	FVector2D BrushSize = FVector2D::ZeroVector;
+	FColor TintColor;
+	FColor FillColor;
+	bool bIsValid = false;
+
+	/** Cached geometry with the transform and UV offset of the current paint applied. */
+	TArray<FSlateVertex> PaintVertices;
+
+	/** Indices of the fill alone, for PaintFill. */
+	TArray<SlateIndex> PaintIndices;
+
+	/** Build queued by UpdateDeferred, with what it builds for. Cancelled once stale. */
+	TSharedPtr<FSplineBuildRequest> PendingBuild;
+	TSharedPtr<FSplineTessellationJob> PendingJob;
+	uint32 PendingVersion = 0;
+	FVector2D PendingBrushSize = FVector2D::ZeroVector;
+	FColor PendingTintColor;
+	FColor PendingFillColor;
+};
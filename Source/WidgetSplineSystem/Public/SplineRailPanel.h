@@ -0,0 +1,74 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PanelWidget.h"
+#include "Data/SlateSplineCurves.h"
+#include "Slate/SplineBuildScheduler.h"
+#include "SplineRailPanel.generated.h"
+
+class SSplineRailPanel;
+class USplineRailPanelSlot;
+
+/**
+ * Panel that places its children along a spline while arranging them.
+ * Placements are only recomputed when the spline or a slot's position changes.
+ */
+UCLASS()
+class WIDGETSPLINESYSTEM_API USplineRailPanel : public UPanelWidget
+{
+	GENERATED_BODY()
+
+public:
+	USplineRailPanel();
+
+	UFUNCTION(BlueprintCallable, Category="Widget")
+	USplineRailPanelSlot* AddChildToRail(UWidget* Content);
+
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	virtual void UpdateSpline();
+
+	/** Replaces the spline data. The spline is updated with every other spline changed this frame, before Slate ticks. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetSplineData(const FSlateSpline& InSplineData);
+
+	/** Queues an update of the spline after SplineData was changed in place. Queued updates run in parallel, before Slate ticks. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void MarkSplineDirty();
+
+	const FSlateSplineCurves* GetSplineCurvesPtr() const { return SplineCurves.Get(); }
+
+protected:
+	virtual UClass* GetSlotClass() const override;
+	virtual void OnSlotAdded(UPanelSlot* InSlot) override;
+	virtual void OnSlotRemoved(UPanelSlot* InSlot) override;
+
+	virtual void OnWidgetRebuilt() override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void Serialize(FArchive& Ar) override;
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override
+	{
+		return NSLOCTEXT("Spline", "Spline", "Spline");
+	};
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+	TSharedPtr<SSplineRailPanel> MyRailPanel;
+
+	/** Built from SplineData and held by the geometry registry. Saved with the widget, so widgets loaded from a saved or cooked package do not rebuild them. */
+	TSharedPtr<const FSlateSplineCurves> SplineCurves;
+
+	/** Build of SplineCurves queued when the widget was rebuilt or its data changed. Children are placed once it runs. */
+	TSharedPtr<FSplineBuildRequest> PendingCurvesBuild;
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetSplineData, Category="Spline Widget")
+	FSlateSpline SplineData = FSlateSpline();
+};
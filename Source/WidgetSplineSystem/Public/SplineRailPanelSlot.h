@@ -0,0 +1,54 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PanelSlot.h"
+#include "Slate/SSplineRailPanel.h"
+#include "SplineRailPanelSlot.generated.h"
+
+/**
+ * Slot of a spline rail panel, placing its content on the spline.
+ */
+UCLASS()
+class WIDGETSPLINESYSTEM_API USplineRailPanelSlot : public UPanelSlot
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="Layout|Spline Rail Slot")
+	void SetPosition(float InPosition);
+
+	UFUNCTION(BlueprintCallable, Category="Layout|Spline Rail Slot")
+	void SetUseNormalizedPosition(bool bInUseNormalizedPosition);
+
+	UFUNCTION(BlueprintCallable, Category="Layout|Spline Rail Slot")
+	void SetAlignment(FVector2D InAlignment);
+
+	UFUNCTION(BlueprintCallable, Category="Layout|Spline Rail Slot")
+	void SetOrientToTangent(bool bInOrientToTangent);
+
+	void BuildSlot(TSharedRef<SSplineRailPanel> InRailPanel);
+
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+public:
+	/** Distance along the spline, or the fraction of its length when using a normalized position. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetPosition, Category="Layout|Spline Rail Slot")
+	float Position = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetUseNormalizedPosition, Category="Layout|Spline Rail Slot")
+	bool bUseNormalizedPosition = false;
+
+	/** Point of the content, relative to its size, that is placed on the spline. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetAlignment, Category="Layout|Spline Rail Slot")
+	FVector2D Alignment = FVector2D(0.5f, 0.5f);
+
+	/** Whether the content is rotated to follow the spline tangent. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetOrientToTangent, Category="Layout|Spline Rail Slot")
+	bool bOrientToTangent = false;
+
+private:
+	SSplineRailPanel::FSlot* Slot = nullptr;
+};
@@ -0,0 +1,70 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SplineWidget.h"
+#include "SplineTextWidget.generated.h"
+
+class SSplineText;
+
+/**
+ * Spline widget that lays text out along its curve.
+ */
+UCLASS()
+class WIDGETSPLINESYSTEM_API USplineTextWidget : public USplineWidget
+{
+	GENERATED_BODY()
+
+public:
+	USplineTextWidget();
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetText(const FText& InText);
+
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetFont(const FSlateFontInfo& InFont);
+
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetColorAndOpacity(const FSlateColor& InColorAndOpacity);
+
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetStartDistance(float InStartDistance);
+
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetBaselineOffset(float InBaselineOffset);
+
+	UFUNCTION(BlueprintCallable, Category = "Spline Text")
+	void SetDrawSpline(bool bInDrawSpline);
+
+protected:
+	TSharedPtr<SSplineText> SlateSplineText;
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetText, Category="Spline Text", meta=(MultiLine="false"))
+	FText Text;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetFont, Category="Spline Text")
+	FSlateFontInfo Font;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetColorAndOpacity, Category="Spline Text")
+	FSlateColor ColorAndOpacity = FLinearColor::White;
+
+	/** Distance along the spline where the text starts. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetStartDistance, Category="Spline Text")
+	float StartDistance = 0.0f;
+
+	/** Offset of the text baseline from the spline, perpendicular to it. Positive values move the text below the spline. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetBaselineOffset, Category="Spline Text")
+	float BaselineOffset = 0.0f;
+
+	/** Whether the spline is drawn underneath the text. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetDrawSpline, Category="Spline Text")
+	bool bDrawSpline = false;
+};
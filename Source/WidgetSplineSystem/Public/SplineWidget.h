@@ -5,9 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/Widget.h"
 #include "Slate/SSpline.h"
-#include "Data/SlateSplineCurves.h"
+#include "Data/SlateSplineCurvesSnapshot.h"
+#include "Data/SplineStrokeFitter.h"
+#include "Slate/SplineBuildScheduler.h"
 #include "SplineWidget.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSplineWidgetHitEvent, const FSplineHitResult&, Hit);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSplineWidgetUnhoveredEvent);
+
 /**
  * 
  */
@@ -18,7 +23,10 @@ class WIDGETSPLINESYSTEM_API USplineWidget : public UWidget
 
 protected:
 	virtual void OnWidgetRebuilt() override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void Serialize(FArchive& Ar) override;
 	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void SynchronizeProperties() override;
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
 	
 #if WITH_EDITOR
@@ -26,21 +34,141 @@ protected:
 	{
 		return NSLOCTEXT("Spline", "Spline", "Spline");
 	};
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
 public:
 	UFUNCTION(BlueprintCallable, Category = Spline)
 	virtual void UpdateSpline();
+
+	/** Replaces the spline data. The spline is updated with every other spline changed this frame, before Slate ticks. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetSplineData(const FSlateSpline& InSplineData);
+
+	/** Queues an update of the spline after SplineData was changed in place. Queued updates run in parallel, before Slate ticks. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void MarkSplineDirty();
+
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetUVOffset(float InUVOffset);
+
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetUVScrollSpeed(float InUVScrollSpeed);
+
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void SetFillColor(FLinearColor InFillColor);
 	
+	/** Starts a freehand stroke at a location in the local space of the widget. The stroke replaces the spline points. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void BeginStroke(FVector2D Location);
+
+	/** Adds a sample to the stroke. The spline is refitted and updated as the samples arrive. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void AddStrokeSample(FVector2D Location);
+
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	void EndStroke();
+
+	/** Tests a location in the local space of the widget against the stroke, whether or not bHitTestStroke is set. */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	bool HitTestStroke(FVector2D Location, FSplineHitResult& OutHit) const;
+
 	FSlateSpline GetSplineData() const { return SplineData; }
+
+	/** Returns SplineData without copying it. For Slate widgets, which read the spline on every paint. */
+	const FSlateSpline* GetSplineDataPtr() const { return &SplineData; }
+
+	/** Changes whenever the spline is updated, including edits of only the widths or colors, which keep the shared curves and their version. */
+	uint32 GetSplineVersion() const;
+
+	/** Returns the curves built from SplineData, building them right away if they are still queued. Shared with every widget that has the same spline data. */
+	const FSlateSplineCurves& GetSplineCurves() const;
+
+	/**
+	 * Returns the curves built from SplineData, to query from any thread. The snapshot stays consistent while the widget updates its spline.
+	 * On the game thread, curves still queued are built right away. Other threads get the curves last built.
+	 */
+	FSlateSplineCurvesSnapshot GetCurvesSnapshot() const;
+
+	/** Returns the curves built from SplineData, or null while they are queued. For Slate widgets, which must not force the build. */
+	const FSlateSplineCurves* GetSplineCurvesPtr() const { return CurvesPublisher.GetPublished().Get(); }
 	
 protected:
 	TSharedPtr<SSpline> SlateSpline;
 
+	/** Built from SplineData and held by the geometry registry. Saved with the widget, so widgets loaded from a saved or cooked package do not rebuild them. */
+	FSlateSplineCurvesPublisher CurvesPublisher;
+
+	/** Build of the published curves queued when the widget was rebuilt or its data changed. */
+	TSharedPtr<FSplineBuildRequest> PendingCurvesBuild;
+
+	/** Bumped by every UpdateSpline, so the geometry and hit testing cached by the Slate widget are rebuilt. */
+	uint32 SplineRevision = 0;
+
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetSplineData, Category="Spline Widget")
 	FSlateSpline SplineData = FSlateSpline();
 
-	UPROPERTY(Transient)
-	FSlateSplineCurves SplineCurves;
+	/** Constant offset of the brush V texture coordinate along the spline. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetUVOffset, Category="Spline Widget")
+	float UVOffset = 0.0f;
+
+	/**
+	 * V texture coordinate units per second the brush scrolls along the spline.
+	 * Applied to the cached geometry every frame; material brushes can pan in the material instead at no cost.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetUVScrollSpeed, Category="Spline Widget")
+	float UVScrollSpeed = 0.0f;
+
+	/**
+	 * Color the inside of a closed loop is filled with, under the stroke. Fully transparent draws no fill.
+	 * The fill is triangulated with the brush geometry and only rebuilt when the spline changes. Loops crossing themselves are filled by the even-odd rule.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter=SetFillColor, Category="Spline Widget")
+	FLinearColor FillColor = FLinearColor::Transparent;
+
+	/** Maximum distance, in slate units, between a sketched stroke and the spline fitted to it. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Spline Widget", meta=(ClampMin="0.1"))
+	float StrokeFitTolerance = 2.0f;
+
+	/** Whether straight lines through the points are drawn until the brush geometry is built. Builds are spread over frames when many splines appear at once. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, AdvancedDisplay, Category="Spline Widget")
+	bool bDrawPolylineWhileBuilding = true;
+
+	/** Whether clicks and hovers are tested against the stroke itself instead of the whole widget. Needed for OnClicked, OnHovered and OnUnhovered. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Spline Widget")
+	bool bHitTestStroke = false;
+
+	/** Slate units beyond the edge of the stroke that still hit it. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Spline Widget", meta=(ClampMin="0.0", EditCondition="bHitTestStroke"))
+	float HitTolerance = 2.0f;
+
+	/** Called when the stroke is clicked. */
+	UPROPERTY(BlueprintAssignable, Category="Spline Widget|Event")
+	FOnSplineWidgetHitEvent OnClicked;
+
+	/** Called when the mouse moves onto the stroke. */
+	UPROPERTY(BlueprintAssignable, Category="Spline Widget|Event")
+	FOnSplineWidgetHitEvent OnHovered;
+
+	/** Called when the mouse leaves the stroke. */
+	UPROPERTY(BlueprintAssignable, Category="Spline Widget|Event")
+	FOnSplineWidgetUnhoveredEvent OnUnhovered;
+
+	/** No longer built or updated. The curves are shared between widgets with the same spline data and swapped whenever it changes. */
+	UE_DEPRECATED(5.3, "SplineCurves is no longer updated. Use GetSplineCurves(), or GetCurvesSnapshot() to query the curves from other threads.")
+	UPROPERTY(Transient, meta=(DeprecatedProperty, DeprecationMessage="No longer updated. Use GetSplineCurves, or GetCurvesSnapshot to query the curves from other threads."))
+	FSlateSplineCurves SplineCurves_DEPRECATED;
+
+protected:
+	void HandleClicked(const FSplineHitResult& Hit);
+	void HandleHovered(const FSplineHitResult& Hit);
+	void HandleUnhovered();
+
+private:
+	void UpdateStrokePoints();
+
+	FSplineStrokeFitter StrokeFitter;
+	bool bIsStrokeActive = false;
 };
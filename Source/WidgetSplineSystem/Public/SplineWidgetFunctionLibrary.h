@@ -15,7 +15,8 @@ enum class ESlateSplineCoordinateSpace : uint8
 };
 
 /**
- * 
+ * Queries on the curves of a spline widget, on the game thread.
+ * Other threads query the snapshot returned by USplineWidget::GetCurvesSnapshot, in local space, instead.
  */
 UCLASS()
 class WIDGETSPLINESYSTEM_API USplineWidgetFunctionLibrary : public UBlueprintFunctionLibrary
@@ -79,6 +80,14 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = Spline)
 	static float GetRotationAngleAtDistanceAlongSpline(const USplineWidget* InSplineWidget, float Distance, ESlateSplineCoordinateSpace CoordinateSpace);
 
+	/**
+	 * Finds the closest point on the spline to each of the given locations, in the local space of the widget, split across worker threads.
+	 * The output arrays are resized to match Locations. Signed distances are positive on the right of the spline as it goes on, with Y pointing down.
+	 */
+	UFUNCTION(BlueprintCallable, Category = Spline)
+	static void FindClosestPointsOnSpline(const USplineWidget* InSplineWidget, const TArray<FVector2D>& Locations, TArray<FVector2D>& OutClosestLocations, TArray<float>& OutInputKeys, TArray<float>& OutSignedDistances);
+
 private:
-	static const FInterpCurvePointVector2D& GetPositionPointSafe(const USplineWidget* InSplineWidget, int32 PointIndex);
+	static FVector2D LocationToSpace(const USplineWidget* InSplineWidget, const FVector2D& Location, ESlateSplineCoordinateSpace CoordinateSpace);
+	static FVector2D VectorToSpace(const USplineWidget* InSplineWidget, const FVector2D& Vector, ESlateSplineCoordinateSpace CoordinateSpace);
 };
@@ -37,6 +37,7 @@ public class WidgetSplineSystem : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"InputCore",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
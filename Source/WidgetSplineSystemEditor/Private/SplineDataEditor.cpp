@@ -0,0 +1,148 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineDataEditor.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "PropertyHandle.h"
+#include "ScopedTransaction.h"
+#include "SplineEditDelta.h"
+#include "SplinePointsChange.h"
+#include "SplineWidget.h"
+#include "WidgetBlueprint.h"
+
+namespace SplineDataEditor
+{
+	/** The widget designer edits a preview of each widget and copies the changed properties to the template in the blueprint. */
+	USplineWidget* FindDesignerTemplate(const USplineWidget* PreviewWidget)
+	{
+		if (!PreviewWidget->IsDesignTime())
+		{
+			return nullptr;
+		}
+
+		const UUserWidget* PreviewUserWidget = PreviewWidget->GetTypedOuter<UUserWidget>();
+		const UWidgetBlueprint* WidgetBlueprint = PreviewUserWidget ? Cast<UWidgetBlueprint>(UBlueprint::GetBlueprintFromClass(PreviewUserWidget->GetClass())) : nullptr;
+		if (!WidgetBlueprint || !WidgetBlueprint->WidgetTree)
+		{
+			return nullptr;
+		}
+
+		// Previews are instanced from the blueprint widget tree, so they keep the names of their templates
+		USplineWidget* Template = Cast<USplineWidget>(WidgetBlueprint->WidgetTree->FindWidget(PreviewWidget->GetFName()));
+		return Template != PreviewWidget ? Template : nullptr;
+	}
+}
+
+FSplineDataEditor::FSplineDataEditor(const TSharedRef<IPropertyHandle>& InPropertyHandle)
+	: PropertyHandle(InPropertyHandle)
+{
+}
+
+FSplineDataEditor::~FSplineDataEditor()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(InteractiveChangeHandle);
+}
+
+void FSplineDataEditor::ApplyInteractiveEdit(const FSplineEditDelta& Delta)
+{
+	FSlateSpline* SplineData = GetSplineData();
+	if (!SplineData || Delta.IsEmpty())
+	{
+		return;
+	}
+
+	// Announced outside of any transaction, so the widgets are not snapshotted. The commit records the delta instead.
+	if (!bIsInteractiveEditActive)
+	{
+		bIsInteractiveEditActive = true;
+		PropertyHandle->NotifyPreChange();
+	}
+
+	Delta.Apply(SplineData->Points);
+
+	if (!InteractiveChangeHandle.IsValid())
+	{
+		InteractiveChangeHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FSplineDataEditor::FlushInteractiveChange));
+	}
+}
+
+void FSplineDataEditor::CommitEdit(const FSplineEditDelta& Delta, const FText& TransactionDescription)
+{
+	FSlateSpline* SplineData = GetSplineData();
+	if (!SplineData || Delta.IsEmpty())
+	{
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(InteractiveChangeHandle);
+	InteractiveChangeHandle.Reset();
+
+	// A drag announced the change on its first move, other edits announce it here. Either way before the transaction opens,
+	// as the pre change modifies the widgets and would record a snapshot of each next to the delta.
+	if (!bIsInteractiveEditActive)
+	{
+		PropertyHandle->NotifyPreChange();
+	}
+	bIsInteractiveEditActive = false;
+
+	// The delta is recorded instead of letting the transaction snapshot the whole widget.
+	// Points written while dragging already hold their new value, applying them again is harmless.
+	const FScopedTransaction Transaction(TransactionDescription);
+	if (GUndo)
+	{
+		for (USplineWidget* EditedWidget : GetEditedWidgets())
+		{
+			GUndo->StoreUndo(EditedWidget, MakeUnique<FSplinePointsChange>(Delta, TransactionDescription));
+		}
+	}
+
+	Delta.Apply(SplineData->Points);
+	PropertyHandle->NotifyPostChange(EPropertyChangeType::ValueSet);
+}
+
+FSlateSpline* FSplineDataEditor::GetSplineData() const
+{
+	if (!PropertyHandle->IsValidHandle())
+	{
+		return nullptr;
+	}
+
+	void* RawData = nullptr;
+	if (PropertyHandle->GetValueData(RawData) != FPropertyAccess::Success)
+	{
+		return nullptr;
+	}
+
+	return static_cast<FSlateSpline*>(RawData);
+}
+
+bool FSplineDataEditor::FlushInteractiveChange(float DeltaTime)
+{
+	InteractiveChangeHandle.Reset();
+	if (PropertyHandle->IsValidHandle())
+	{
+		PropertyHandle->NotifyPostChange(EPropertyChangeType::Interactive);
+	}
+	return false;
+}
+
+TArray<USplineWidget*> FSplineDataEditor::GetEditedWidgets() const
+{
+	TArray<UObject*> OuterObjects;
+	PropertyHandle->GetOuterObjects(OuterObjects);
+
+	TArray<USplineWidget*> EditedWidgets;
+	for (UObject* OuterObject : OuterObjects)
+	{
+		if (USplineWidget* EditedWidget = Cast<USplineWidget>(OuterObject))
+		{
+			EditedWidgets.AddUnique(EditedWidget);
+			if (USplineWidget* Template = SplineDataEditor::FindDesignerTemplate(EditedWidget))
+			{
+				EditedWidgets.AddUnique(Template);
+			}
+		}
+	}
+	return EditedWidgets;
+}
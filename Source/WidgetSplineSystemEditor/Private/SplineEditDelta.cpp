@@ -0,0 +1,54 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineEditDelta.h"
+
+void FSplineEditDelta::Apply(TArray<FSlateSplinePoint>& Points) const
+{
+	for (const FSplinePointEdit& Edit : Edits)
+	{
+		switch (Edit.Type)
+		{
+		case FSplinePointEdit::EType::Modify:
+			if (Points.IsValidIndex(Edit.Index))
+			{
+				Points[Edit.Index] = Edit.NewPoint;
+			}
+			break;
+		case FSplinePointEdit::EType::Insert:
+			Points.Insert(Edit.NewPoint, FMath::Clamp(Edit.Index, 0, Points.Num()));
+			break;
+		case FSplinePointEdit::EType::Remove:
+			if (Points.IsValidIndex(Edit.Index))
+			{
+				Points.RemoveAt(Edit.Index);
+			}
+			break;
+		}
+	}
+}
+
+void FSplineEditDelta::Revert(TArray<FSlateSplinePoint>& Points) const
+{
+	for (int32 i = Edits.Num() - 1; i >= 0; i--)
+	{
+		const FSplinePointEdit& Edit = Edits[i];
+		switch (Edit.Type)
+		{
+		case FSplinePointEdit::EType::Modify:
+			if (Points.IsValidIndex(Edit.Index))
+			{
+				Points[Edit.Index] = Edit.OldPoint;
+			}
+			break;
+		case FSplinePointEdit::EType::Insert:
+			if (Points.IsValidIndex(Edit.Index))
+			{
+				Points.RemoveAt(Edit.Index);
+			}
+			break;
+		case FSplinePointEdit::EType::Remove:
+			Points.Insert(Edit.OldPoint, FMath::Clamp(Edit.Index, 0, Points.Num()));
+			break;
+		}
+	}
+}
@@ -0,0 +1,159 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineEditHitGrid.h"
+
+void FSplineEditHitGrid::Reset(float InCellSize, int32 InNumPoints)
+{
+	CellSize = FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER);
+	for (int32 Handle = 0; Handle < NumHandles; Handle++)
+	{
+		Cells[Handle].Reset();
+		PointCells[Handle].Init(FIntPoint(MAX_int32, MAX_int32), InNumPoints);
+		PointLocations[Handle].SetNumZeroed(InNumPoints);
+	}
+}
+
+void FSplineEditHitGrid::SetPoint(int32 PointIndex, const FHandleLocations& HandleLocations)
+{
+	for (int32 Handle = 0; Handle < NumHandles; Handle++)
+	{
+		PointLocations[Handle][PointIndex] = HandleLocations[Handle];
+
+		const FIntPoint NewCell = GetCell(HandleLocations[Handle]);
+		FIntPoint& PointCell = PointCells[Handle][PointIndex];
+		if (PointCell == NewCell)
+		{
+			continue;
+		}
+
+		if (TArray<int32, TInlineAllocator<4>>* OldCell = Cells[Handle].Find(PointCell))
+		{
+			OldCell->RemoveSingleSwap(PointIndex);
+			if (OldCell->Num() == 0)
+			{
+				Cells[Handle].Remove(PointCell);
+			}
+		}
+
+		Cells[Handle].FindOrAdd(NewCell).Add(PointIndex);
+		PointCell = NewCell;
+	}
+}
+
+int32 FSplineEditHitGrid::FindPoint(EHandle Handle, const FVector2D& InputPosition) const
+{
+	const int32 HandleIndex = static_cast<int32>(Handle);
+	const float HalfCellSize = CellSize * 0.5f;
+	const FIntPoint MinCell = GetCell(InputPosition - HalfCellSize);
+	const FIntPoint MaxCell = GetCell(InputPosition + HalfCellSize);
+
+	int32 FoundIndex = INDEX_NONE;
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Cell = Cells[HandleIndex].Find(FIntPoint(CellX, CellY));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const int32 PointIndex : *Cell)
+			{
+				const FVector2D Delta = (PointLocations[HandleIndex][PointIndex] - InputPosition).GetAbs();
+				if (Delta.X < HalfCellSize && Delta.Y < HalfCellSize && (FoundIndex == INDEX_NONE || PointIndex < FoundIndex))
+				{
+					FoundIndex = PointIndex;
+				}
+			}
+		}
+	}
+
+	return FoundIndex;
+}
+
+void FSplineEditHitGrid::FindPointsInBox(EHandle Handle, const FBox2D& InputBox, TBitArray<>& OutPoints) const
+{
+	const int32 HandleIndex = static_cast<int32>(Handle);
+	OutPoints.Init(false, GetNumPoints());
+	if (!InputBox.bIsValid)
+	{
+		return;
+	}
+
+	const auto& AddCellPoints = [&](const TArray<int32, TInlineAllocator<4>>& Cell)
+	{
+		for (const int32 PointIndex : Cell)
+		{
+			if (InputBox.IsInsideOrOn(PointLocations[HandleIndex][PointIndex]))
+			{
+				OutPoints[PointIndex] = true;
+			}
+		}
+	};
+
+	// A box much larger than the spline covers more cells than there are occupied ones
+	const FIntPoint MinCell = GetCell(InputBox.Min);
+	const FIntPoint MaxCell = GetCell(InputBox.Max);
+	const int64 NumBoxCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+	if (NumBoxCells > Cells[HandleIndex].Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32, TInlineAllocator<4>>>& Cell : Cells[HandleIndex])
+		{
+			AddCellPoints(Cell.Value);
+		}
+		return;
+	}
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			if (const TArray<int32, TInlineAllocator<4>>* Cell = Cells[HandleIndex].Find(FIntPoint(CellX, CellY)))
+			{
+				AddCellPoints(*Cell);
+			}
+		}
+	}
+}
+
+void FSplineEditHitGrid::FindPointsInPolygon(EHandle Handle, TConstArrayView<FVector2D> InputPolygon, TBitArray<>& OutPoints) const
+{
+	if (InputPolygon.Num() < 3)
+	{
+		OutPoints.Init(false, GetNumPoints());
+		return;
+	}
+
+	TBitArray<> Candidates;
+	FindPointsInBox(Handle, FBox2D(InputPolygon.GetData(), InputPolygon.Num()), Candidates);
+	OutPoints = Candidates;
+
+	// Even-odd rule, only for the points inside the bounds of the polygon
+	const int32 HandleIndex = static_cast<int32>(Handle);
+	for (TConstSetBitIterator<> It(Candidates); It; ++It)
+	{
+		const FVector2D& Location = PointLocations[HandleIndex][It.GetIndex()];
+		bool bIsInside = false;
+		for (int32 i = 0, j = InputPolygon.Num() - 1; i < InputPolygon.Num(); j = i++)
+		{
+			const FVector2D& A = InputPolygon[i];
+			const FVector2D& B = InputPolygon[j];
+			if ((A.Y > Location.Y) != (B.Y > Location.Y)
+				&& Location.X < (B.X - A.X) * (Location.Y - A.Y) / (B.Y - A.Y) + A.X)
+			{
+				bIsInside = !bIsInside;
+			}
+		}
+
+		if (!bIsInside)
+		{
+			OutPoints[It.GetIndex()] = false;
+		}
+	}
+}
+
+FIntPoint FSplineEditHitGrid::GetCell(const FVector2D& InputPosition) const
+{
+	return FIntPoint(FMath::FloorToInt(InputPosition.X / CellSize), FMath::FloorToInt(InputPosition.Y / CellSize));
+}
@@ -0,0 +1,47 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplinePointsChange.h"
+
+#include "SplineWidget.h"
+
+void FSplinePointsChange::Apply(UObject* Object)
+{
+	if (USplineWidget* SplineWidget = Cast<USplineWidget>(Object))
+	{
+		NotifySplineDataChanging(SplineWidget);
+		Delta.Apply(SplineWidget->SplineData.Points);
+		NotifySplineDataChanged(SplineWidget);
+	}
+}
+
+void FSplinePointsChange::Revert(UObject* Object)
+{
+	if (USplineWidget* SplineWidget = Cast<USplineWidget>(Object))
+	{
+		NotifySplineDataChanging(SplineWidget);
+		Delta.Revert(SplineWidget->SplineData.Points);
+		NotifySplineDataChanged(SplineWidget);
+	}
+}
+
+FString FSplinePointsChange::ToString() const
+{
+	return Description.ToString();
+}
+
+FProperty* FSplinePointsChange::GetSplineDataProperty()
+{
+	return FindFProperty<FProperty>(USplineWidget::StaticClass(), GET_MEMBER_NAME_CHECKED(USplineWidget, SplineData));
+}
+
+void FSplinePointsChange::NotifySplineDataChanging(UObject* Object)
+{
+	Object->PreEditChange(GetSplineDataProperty());
+}
+
+void FSplinePointsChange::NotifySplineDataChanged(UObject* Object)
+{
+	FPropertyChangedEvent PropertyChangedEvent(GetSplineDataProperty(), EPropertyChangeType::ValueSet);
+	Object->PostEditChangeProperty(PropertyChangedEvent);
+	Object->MarkPackageDirty();
+}
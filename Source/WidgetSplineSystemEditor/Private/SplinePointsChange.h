@@ -0,0 +1,32 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Change.h"
+#include "SplineEditDelta.h"
+
+/** Undo record of a spline edit that stores only the edited points instead of a snapshot of the whole widget. */
+class FSplinePointsChange final : public FCommandChange
+{
+public:
+	FSplinePointsChange(const FSplineEditDelta& InDelta, const FText& InDescription)
+		: Delta(InDelta)
+		, Description(InDescription)
+	{}
+
+	virtual void Apply(UObject* Object) override;
+	virtual void Revert(UObject* Object) override;
+	virtual FString ToString() const override;
+
+private:
+	static FProperty* GetSplineDataProperty();
+
+	/** Pairs with NotifySplineDataChanged, so the widget sees the same pre and post change as for an edit in the details panel. */
+	static void NotifySplineDataChanging(UObject* Object);
+
+	/** Lets the widget and the editor react to the edited points as to a property change. */
+	static void NotifySplineDataChanged(UObject* Object);
+
+	FSplineEditDelta Delta;
+	FText Description;
+};
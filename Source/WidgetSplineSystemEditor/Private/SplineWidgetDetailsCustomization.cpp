@@ -5,6 +5,7 @@
 #include "DetailCategoryBuilder.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
+#include "SplineDataEditor.h"
 #include "SplineWidget.h"
 #include "SplineWidgetEditPanel.h"
 
@@ -22,8 +23,8 @@ void FSplineWidgetDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 	{
 		return;
 	}
-	
-	USplineWidget* SplineWidget = nullptr;
+
+	SplineWidget.Reset();
 	for (const TWeakObjectPtr<UObject> Object : SelectedObjects)
 	{
 		if (USplineWidget* TestSplineWidget = Cast<USplineWidget>(Object))
@@ -33,13 +34,19 @@ void FSplineWidgetDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 		}
 	}
 
-	if (!SplineWidget)
+	if (!SplineWidget.IsValid())
 	{
 		return;
 	}
 
-	const TSharedPtr<IPropertyHandle> PropertySplineInfo = DetailLayout.GetProperty(GET_MEMBER_NAME_CHECKED(USplineWidget, SplineData), USplineWidget::StaticClass());
+	const TSharedRef<IPropertyHandle> PropertySplineInfo = DetailLayout.GetProperty(GET_MEMBER_NAME_CHECKED(USplineWidget, SplineData), USplineWidget::StaticClass());
 	check(PropertySplineInfo->IsValidHandle());
+	SplineDataEditor = MakeShared<FSplineDataEditor>(PropertySplineInfo);
+
+	// Edits made through the regular property rows move points behind the back of the edit panel
+	const FSimpleDelegate OnSplineDataChanged = FSimpleDelegate::CreateSP(this, &FSplineWidgetDetailCustomization::OnSplineDataChanged);
+	PropertySplineInfo->SetOnPropertyValueChanged(OnSplineDataChanged);
+	PropertySplineInfo->SetOnChildPropertyValueChanged(OnSplineDataChanged);
 
 	// Make sure the EditSpline category is right below the Appearance category
 	IDetailCategoryBuilder& EditSplineCategory = DetailLayout.EditCategory("SplineWidget", FText::GetEmpty(), ECategoryPriority::TypeSpecific);
@@ -52,19 +59,25 @@ void FSplineWidgetDetailCustomization::CustomizeDetails(IDetailLayoutBuilder& De
 			[
 				SNew(SBox)
 				[
-					SNew(SSplineWidgetEditPanel)
-					.SplineData_UObject(SplineWidget, &USplineWidget::GetSplineData)
+					SAssignNew(EditPanel, SSplineWidgetEditPanel)
+					.OnGetSplineData_UObject(SplineWidget.Get(), &USplineWidget::GetSplineDataPtr)
+					.SplineVersion_UObject(SplineWidget.Get(), &USplineWidget::GetSplineVersion)
+					.OnGetSplineCurves_UObject(SplineWidget.Get(), &USplineWidget::GetSplineCurvesPtr)
 					.Clipping(EWidgetClipping::ClipToBounds)
-					.OnSplineDataChanged(FOnSplineDataChanged::CreateLambda([=](const FSlateSpline& NewSplineInfo)
-					{
-						FString TextValue;
-						FSlateSpline::StaticStruct()->ExportText(TextValue, &NewSplineInfo, &NewSplineInfo, nullptr, PPF_None, nullptr);
-						const FPropertyAccess::Result Result = PropertySplineInfo->SetValueFromFormattedString(TextValue, EPropertyValueSetFlags::NotTransactable);
-						check(Result == FPropertyAccess::Success);
-					}))	
+					.OnSplineEdited(SplineDataEditor.ToSharedRef(), &FSplineDataEditor::CommitEdit)
+					.OnSplinePointsChanged(SplineDataEditor.ToSharedRef(), &FSplineDataEditor::ApplyInteractiveEdit)
 				]
 			]
 		];
 }
 
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
+void FSplineWidgetDetailCustomization::OnSplineDataChanged()
+{
+	// The panel keeps its own hit grid up to date while it drives an interactive edit
+	if (EditPanel.IsValid() && SplineDataEditor.IsValid() && !SplineDataEditor->IsInteractiveEditActive())
+	{
+		EditPanel->InvalidateSplineData();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
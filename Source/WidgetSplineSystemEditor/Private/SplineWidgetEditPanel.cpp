@@ -2,8 +2,6 @@
 
 #include "SplineWidgetEditPanel.h"
 
-#include "ScopedTransaction.h"
-#include "Slate/SplineBuilder.h"
 #include "Styling/ToolBarStyle.h"
 
 #define LOCTEXT_NAMESPACE "SSplineWidgetEditPanel"
@@ -19,11 +17,32 @@ static constexpr float TangentMaxStrength = 2000.0f;
 void SSplineWidgetEditPanel::Construct(const FArguments& InArgs)
 {
 	SplineData = InArgs._SplineData;
-	OnSplineDataChanged = InArgs._OnSplineDataChanged;
+	OnGetSplineData = InArgs._OnGetSplineData;
+	SplineVersion = InArgs._SplineVersion;
+	OnSplineEdited = InArgs._OnSplineEdited;
+	OnSplinePointsChanged = InArgs._OnSplinePointsChanged;
+	OnGetSplineCurves = InArgs._OnGetSplineCurves;
+
+	if (GetSplineData().Points.Num() > 0)
+	{
+		SelectPoint(0, false);
+	}
 
 	ChildSlot
 	[
-		CreateZoomToFitButton()
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Top)
+		[
+			CreateZoomToFitButton()
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Top)
+		[
+			CreateDrawStrokeButton()
+		]
 	];
 
 	RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateLambda([&](double InCurrentTime, float InDeltaTime)
@@ -36,15 +55,14 @@ int32 SSplineWidgetEditPanel::OnPaint(const FPaintArgs& Args, const FGeometry& A
 	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId,
 	const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	// TODO: Refactor duplicated code from SSpline
-	const FSlateSpline& SplineRef = SplineData.Get();
+	const FSlateSpline& SplineRef = GetSplineData();
 	FSlatePaintContext PaintContext(OutDrawElements, AllottedGeometry, LayerId + 1,
 		ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect,
 		SplineRef.Brush.TintColor.GetColor(InWidgetStyle).ToFColorSRGB());
 
 	if (SplineRef.Points.Num() > 1)
 	{
-		if (SplineRef.Brush.GetResourceObject()->IsValidLowLevel())
+		if (BrushResource.Update(SplineRef.Brush))
 		{
 			PaintSplineBrush(PaintContext);
 		}
@@ -55,7 +73,11 @@ int32 SSplineWidgetEditPanel::OnPaint(const FPaintArgs& Args, const FGeometry& A
 	}
 
 	PaintContext.LayerId++;
-	PaintSplinePoints(PaintContext);
+	PaintSplinePoints(PaintContext, MyCullingRect);
+
+	PaintContext.LayerId++;
+	PaintMarquee(PaintContext);
+	PaintStroke(PaintContext);
 	
 	PaintContext.LayerId++;
 	return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, PaintContext.LayerId, InWidgetStyle, bParentEnabled) + 1;
@@ -104,7 +126,12 @@ FReply SSplineWidgetEditPanel::OnMouseButtonUp(const FGeometry& MyGeometry, cons
 
 	if (DragState != EDragState::PreDrag)
 	{
-		DragState = EDragState::None;
+		if (DragState == EDragState::Marquee || DragState == EDragState::Lasso)
+		{
+			ApplyMarqueeSelection(MouseEvent.IsShiftDown(), MouseEvent.IsControlDown());
+		}
+
+		FinishDrag();
 		return FReply::Handled().ReleaseMouseCapture();
 	}
 	
@@ -115,23 +142,36 @@ FReply SSplineWidgetEditPanel::OnMouseButtonUp(const FGeometry& MyGeometry, cons
 	{
 		if (HitPointIndex != INVALID_INDEX)
 		{
-			SelectedPointIndex = HitPointIndex;
+			// Shift toggles the clicked point in and out of the selection
+			if (MouseEvent.IsShiftDown() && IsPointSelected(HitPointIndex))
+			{
+				SelectedPoints[HitPointIndex] = false;
+				SelectedPointIndex = SelectedPoints.Find(true);
+			}
+			else
+			{
+				SelectPoint(HitPointIndex, MouseEvent.IsShiftDown());
+			}
 		}
 		else
 		{
 			const int HitTangent = GetSplineTangentUnderPosition(LocalMousePosition, bIsSelectedTangentArrival);
 			if (HitTangent != INVALID_INDEX)
 			{
-				SelectedPointIndex = HitTangent;
+				SelectPoint(HitTangent, false);
+			}
+			else if (!MouseEvent.IsShiftDown())
+			{
+				ClearSelection();
 			}
 		}
 	};
 
 	auto HandleRightClick = [&]()
 	{
-		if (HitPointIndex != INVALID_INDEX)
+		if (HitPointIndex != INVALID_INDEX && !IsPointSelected(HitPointIndex))
 		{
-			SelectedPointIndex = HitPointIndex;
+			SelectPoint(HitPointIndex, false);
 		}
 		CreateContextMenu(MyGeometry, MouseEvent);
 	};
@@ -159,46 +199,60 @@ FReply SSplineWidgetEditPanel::OnMouseMove(const FGeometry& MyGeometry, const FP
 											|| MouseEvent.IsMouseButtonDown(EKeys::RightMouseButton);
 		
 		DragState = bIsMouseButtonDown ? EDragState::Pan : EDragState::None;
-		if (MouseEvent.IsMouseButtonDown(EKeys::LeftMouseButton))
+		if (MouseEvent.IsMouseButtonDown(EKeys::LeftMouseButton) && bIsDrawModeActive)
+		{
+			// The fitting error is kept constant on screen whatever the zoom
+			constexpr float StrokeTolerance = 2.0f;
+			DragState = EDragState::DrawStroke;
+			StrokeFitter.Reset(StrokeTolerance / TransformInfo.Scale, StrokeTolerance / TransformInfo.Scale);
+			StrokeFitter.AddSample(TransformInfo.LocalToInput(LastMouseDownLocation));
+		}
+		else if (MouseEvent.IsMouseButtonDown(EKeys::LeftMouseButton))
 		{
 			if (const int HitPointIndex = GetSplinePointUnderPosition(LastMouseDownLocation);
 				HitPointIndex != INVALID_INDEX)
 			{
-				DragState = EDragState::DragKey;
+				// Dragging a selected point transforms the whole selection: Ctrl rotates it and Alt scales it
+				if (!IsPointSelected(HitPointIndex))
+				{
+					SelectPoint(HitPointIndex, MouseEvent.IsShiftDown());
+				}
 				SelectedPointIndex = HitPointIndex;
-				PreDragPointLocation = MousePosition;
+
+				DragState = EDragState::DragSelection;
+				BeginSelectionTransform(MouseEvent.IsControlDown() ? ESelectionTransform::Rotate
+					: MouseEvent.IsAltDown() ? ESelectionTransform::Scale
+					: ESelectionTransform::Translate);
 			}
 			else if (const int HitTangent = GetSplineTangentUnderPosition(LastMouseDownLocation, bIsSelectedTangentArrival);
 					HitTangent != INVALID_INDEX)
 			{
 				DragState = EDragState::DragTangent;
-				SelectedPointIndex = HitTangent;
-				PreDragPointLocation = SplineData.Get().Points[HitTangent].Direction;
+				SelectPoint(HitTangent, false);
+				const FSlateSplinePoint& PreDragPoint = GetSplineData().Points[HitTangent];
+				DragDelta = FSplinePointEdit::MakeModify(HitTangent, PreDragPoint, PreDragPoint);
 			}
 			else
 			{
-				DragState = EDragState::Pan;
+				// Alt draws a lasso instead of a marquee
+				DragState = MouseEvent.IsAltDown() ? EDragState::Lasso : EDragState::Marquee;
+				MarqueePoints.Reset();
+				MarqueePoints.Add(LastMouseDownLocation);
 			}
 		}
 	}
 	
 	if (DragState != EDragState::None)
 	{
-		FSlateSpline NewSplineData = SplineData.Get();
-		if (DragState == EDragState::DragKey)
+		// The dragged points are only reported while dragging, the whole edit is committed once the drag finishes
+		if (DragState == EDragState::DragSelection)
 		{
-			// Begin a new transaction for undo/redo purposes.
-			const FScopedTransaction Transaction(LOCTEXT("MoveSplinePoint", "Moved spline point"));
-			NewSplineData.Points[SelectedPointIndex].Location = TransformInfo.LocalToInput(MousePosition);
-			OnSplineDataChanged.ExecuteIfBound(NewSplineData);
+			UpdateSelectionTransform(MousePosition);
 		}
 		else if (DragState == EDragState::DragTangent)
 		{
-			// Begin a new transaction for undo/redo purposes.
-			const FScopedTransaction Transaction(LOCTEXT("MoveTangentPoint", "Moved tangent point"));
-			
-			const FVector2D KeyLocation = SplineData.Get().Points[SelectedPointIndex].Location;
-			const FVector2D KeyLocalLocation = TransformInfo.InputToLocal(KeyLocation);
+			FSlateSplinePoint& NewPoint = DragDelta.Edits[0].NewPoint;
+			const FVector2D KeyLocalLocation = TransformInfo.InputToLocal(NewPoint.Location);
 		
 			const float Distance = FMath::Max(KeyTangentOffsetMin, FVector2D::Distance(MousePosition, KeyLocalLocation));
 			const float Alpha = FMath::Max(0.01f, (Distance - KeyTangentOffsetMin) / (KeyTangentOffsetMax - KeyTangentOffsetMin));
@@ -208,9 +262,28 @@ FReply SSplineWidgetEditPanel::OnMouseMove(const FGeometry& MyGeometry, const FP
 			NewDirection.Normalize();
 			NewDirection = NewDirection * Strength;
 			
-			NewSplineData.Points[SelectedPointIndex].Direction = NewDirection;
-			OnSplineDataChanged.ExecuteIfBound(NewSplineData);
-
+			NewPoint.Direction = NewDirection;
+			OnSplinePointsChanged.ExecuteIfBound(DragDelta);
+			HitGrid.SetPoint(SelectedPointIndex, ComputeHandleLocations(NewPoint));
+			Tessellation.Invalidate();
+			bIsKeyHandleBatchDirty = true;
+		}
+		else if (DragState == EDragState::Marquee)
+		{
+			MarqueePoints.SetNum(2);
+			MarqueePoints[1] = MousePosition;
+		}
+		else if (DragState == EDragState::Lasso)
+		{
+			constexpr float MinLassoStep = 4.0f;
+			if (FVector2D::DistSquared(MarqueePoints.Last(), MousePosition) >= FMath::Square(MinLassoStep))
+			{
+				MarqueePoints.Add(MousePosition);
+			}
+		}
+		else if (DragState == EDragState::DrawStroke)
+		{
+			StrokeFitter.AddSample(TransformInfo.LocalToInput(MousePosition));
 		}
 		else if (DragState == EDragState::Pan)
 		{
@@ -238,102 +311,342 @@ void SSplineWidgetEditPanel::OnMouseLeave(const FPointerEvent& MouseEvent)
 
 void SSplineWidgetEditPanel::OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent)
 {
+	FinishDrag();
+}
+
+void SSplineWidgetEditPanel::PostUndo(bool bSuccess)
+{
+	InvalidateSplineData();
+}
+
+void SSplineWidgetEditPanel::PostRedo(bool bSuccess)
+{
+	InvalidateSplineData();
+}
+
+void SSplineWidgetEditPanel::InvalidateSplineData()
+{
+	bIsHitGridDirty = true;
+	bIsKeyHandleBatchDirty = true;
+	Tessellation.Invalidate();
+
+	// Indices no longer match the points once some were added or removed
+	if (SelectedPoints.Num() != GetSplineData().Points.Num())
+	{
+		ClearSelection();
+	}
+}
+
+void SSplineWidgetEditPanel::FinishDrag()
+{
+	if ((DragState == EDragState::DragSelection || DragState == EDragState::DragTangent) && !DragDelta.IsEmpty())
+	{
+		FText Description = LOCTEXT("MoveTangentPoint", "Moved tangent point");
+		if (DragState == EDragState::DragSelection)
+		{
+			switch (SelectionTransform)
+			{
+			case ESelectionTransform::Translate:
+				Description = LOCTEXT("MoveSplinePoints", "Moved spline points");
+				break;
+			case ESelectionTransform::Rotate:
+				Description = LOCTEXT("RotateSplinePoints", "Rotated spline points");
+				break;
+			case ESelectionTransform::Scale:
+				Description = LOCTEXT("ScaleSplinePoints", "Scaled spline points");
+				break;
+			}
+		}
+
+		OnSplineEdited.ExecuteIfBound(DragDelta, Description);
+	}
+	else if (DragState == EDragState::DrawStroke)
+	{
+		StrokeFitter.Finish();
+		TArray<FSlateSplinePoint> StrokePoints;
+		StrokeFitter.GetPoints(StrokePoints);
+
+		// The stroke replaces every point of the spline in a single edit
+		if (StrokePoints.Num() > 1)
+		{
+			const TArray<FSlateSplinePoint>& Points = GetSplineData().Points;
+			FSplineEditDelta Delta;
+			for (int32 i = Points.Num() - 1; i >= 0; --i)
+			{
+				Delta.Edits.Add(FSplinePointEdit::MakeRemove(i, Points[i]));
+			}
+			for (int32 i = 0; i < StrokePoints.Num(); ++i)
+			{
+				Delta.Edits.Add(FSplinePointEdit::MakeInsert(i, StrokePoints[i]));
+			}
+
+			OnSplineEdited.ExecuteIfBound(Delta, LOCTEXT("DrawSplineStroke", "Draw Spline"));
+			InvalidateSplineData();
+			SelectPoint(StrokePoints.Num() - 1, false);
+		}
+		StrokeFitter.Reset();
+	}
+
+	DragDelta.Edits.Reset();
+	MarqueePoints.Reset();
 	DragState = EDragState::None;
 }
 
-void SSplineWidgetEditPanel::PaintSplineSimple(const FSlatePaintContext& InPaintContext) const
+void SSplineWidgetEditPanel::SelectPoint(int32 PointIndex, bool bAddToSelection)
 {
-	const FSlateSpline& SplineRef = SplineData.Get();
-	const auto& DrawSplineSegment = [&](const FSlateSplinePoint& SegmentStart, const FSlateSplinePoint& SegmentEnd){
-		const FVector2D& SegmentStartDirection = SplineRef.bIsLinear ? FVector2D::ZeroVector : SegmentStart.Direction * TransformInfo.Scale;
-		const FVector2D& SegmentEndDirection = SplineRef.bIsLinear ? FVector2D::ZeroVector : SegmentEnd.Direction * TransformInfo.Scale;
-		FSlateDrawElement::MakeSpline(
-				InPaintContext.OutDrawElements,
-				InPaintContext.LayerId,
-				InPaintContext.AllotedGeometry.ToPaintGeometry(),
-				TransformInfo.InputToLocal(SegmentStart.Location),
-				SegmentStartDirection,
-				TransformInfo.InputToLocal(SegmentEnd.Location),
-				SegmentEndDirection,
-				SplineRef.Brush.GetImageSize().X,
-				InPaintContext.DrawEffect,
-				InPaintContext.TintColor);
-	};
-	
-	for (int i = 0; i < SplineRef.Points.Num() - 1; i++)
+	const int32 NumPoints = GetSplineData().Points.Num();
+	if (!bAddToSelection || SelectedPoints.Num() != NumPoints)
 	{
-		DrawSplineSegment(SplineRef.Points[i], SplineRef.Points[i + 1]);
+		SelectedPoints.Init(false, NumPoints);
 	}
-	
-	if (SplineRef.bIsClosedLoop)
+
+	if (SelectedPoints.IsValidIndex(PointIndex))
 	{
-		DrawSplineSegment(SplineRef.Points.Last(), SplineRef.Points[0]);
+		SelectedPoints[PointIndex] = true;
+		SelectedPointIndex = PointIndex;
 	}
 }
 
-void SSplineWidgetEditPanel::PaintSplineBrush(const FSlatePaintContext& InPaintContext) const
+void SSplineWidgetEditPanel::ClearSelection()
 {
-	const FSlateSpline& SplineRef = SplineData.Get();
-	FSplineBuilder SplineBuilder(SplineRef.Brush.GetImageSize(), InPaintContext);
-	
-	for (int i = 0; i < SplineRef.Points.Num() - 1; i++)
+	SelectedPoints.Init(false, GetSplineData().Points.Num());
+	SelectedPointIndex = INVALID_INDEX;
+}
+
+void SSplineWidgetEditPanel::ApplyMarqueeSelection(bool bAddToSelection, bool bRemoveFromSelection)
+{
+	if (MarqueePoints.Num() < 2)
 	{
-		FSlateSplinePoint SegmentStart =  SplineRef.Points[i];
-		SegmentStart.Location = TransformInfo.InputToLocal(SegmentStart.Location);
-		SegmentStart.Direction = SegmentStart.Direction * TransformInfo.Scale;
+		return;
+	}
 
-		FSlateSplinePoint SegmentEnd =  SplineRef.Points[i+1];
-		SegmentEnd.Location = TransformInfo.InputToLocal(SegmentEnd.Location);
-		SegmentEnd.Direction = SegmentEnd.Direction * TransformInfo.Scale;
-		
-		SplineBuilder.BuildBezierGeometry(SegmentStart, SegmentEnd, SplineRef.bIsLinear);
+	UpdateHitGrid();
+
+	TBitArray<> MarqueeSelection;
+	if (DragState == EDragState::Marquee)
+	{
+		FBox2D InputBox(ForceInit);
+		InputBox += TransformInfo.LocalToInput(MarqueePoints[0]);
+		InputBox += TransformInfo.LocalToInput(MarqueePoints[1]);
+		HitGrid.FindPointsInBox(FSplineEditHitGrid::EHandle::Key, InputBox, MarqueeSelection);
 	}
-	
-	if (SplineRef.bIsClosedLoop)
+	else
 	{
-		FSlateSplinePoint SegmentStart = SplineRef.Points.Last();
-		SegmentStart.Location = TransformInfo.InputToLocal(SegmentStart.Location);
-		SegmentStart.Direction = SegmentStart.Direction * TransformInfo.Scale;
+		TArray<FVector2D> InputPolygon;
+		InputPolygon.Reserve(MarqueePoints.Num());
+		for (const FVector2D& LocalPoint : MarqueePoints)
+		{
+			InputPolygon.Add(TransformInfo.LocalToInput(LocalPoint));
+		}
+		HitGrid.FindPointsInPolygon(FSplineEditHitGrid::EHandle::Key, InputPolygon, MarqueeSelection);
+	}
 
-		FSlateSplinePoint SegmentEnd = SplineRef.Points[0];
-		SegmentEnd.Location = TransformInfo.InputToLocal(SegmentEnd.Location);
-		SegmentEnd.Direction = SegmentEnd.Direction * TransformInfo.Scale;
-		
-		SplineBuilder.BuildBezierGeometry(SegmentStart, SegmentEnd, SplineRef.bIsLinear);
+	if (!bAddToSelection && !bRemoveFromSelection)
+	{
+		SelectedPoints = MoveTemp(MarqueeSelection);
 	}
+	else
+	{
+		if (SelectedPoints.Num() != MarqueeSelection.Num())
+		{
+			SelectedPoints.Init(false, MarqueeSelection.Num());
+		}
 
-	SplineBuilder.Finish(SplineRef.bIsClosedLoop);
-	
-	
-	const FSlateResourceHandle& RenderResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(SplineRef.Brush);
-	FSlateDrawElement::MakeCustomVerts(InPaintContext.OutDrawElements, InPaintContext.LayerId, RenderResourceHandle, SplineBuilder.GetVertexArray(), SplineBuilder.GetIndexArray(), nullptr, 0, 0, InPaintContext.DrawEffect);
+		for (TConstSetBitIterator<> It(MarqueeSelection); It; ++It)
+		{
+			SelectedPoints[It.GetIndex()] = !bRemoveFromSelection;
+		}
+	}
+
+	if (!IsPointSelected(SelectedPointIndex))
+	{
+		SelectedPointIndex = SelectedPoints.Find(true);
+	}
 }
 
-void SSplineWidgetEditPanel::PaintSplinePoints(const FSlatePaintContext& InPaintContext) const
+void SSplineWidgetEditPanel::BeginSelectionTransform(ESelectionTransform InTransform)
+{
+	SelectionTransform = InTransform;
+	DragDelta.Edits.Reset();
+
+	const TArray<FSlateSplinePoint>& Points = GetSplineData().Points;
+	FBox2D SelectionBounds(ForceInit);
+	for (TConstSetBitIterator<> It(SelectedPoints); It; ++It)
+	{
+		if (Points.IsValidIndex(It.GetIndex()))
+		{
+			const FSlateSplinePoint& Point = Points[It.GetIndex()];
+			DragDelta.Edits.Add(FSplinePointEdit::MakeModify(It.GetIndex(), Point, Point));
+			SelectionBounds += Point.Location;
+		}
+	}
+
+	SelectionPivot = SelectionBounds.bIsValid ? SelectionBounds.GetCenter() : FVector2D::ZeroVector;
+}
+
+void SSplineWidgetEditPanel::UpdateSelectionTransform(const FVector2D& LocalMousePosition)
+{
+	if (DragDelta.IsEmpty())
+	{
+		return;
+	}
+
+	const FVector2D StartPosition = TransformInfo.LocalToInput(LastMouseDownLocation);
+	const FVector2D CurrentPosition = TransformInfo.LocalToInput(LocalMousePosition);
+
+	FTransform2D Transform;
+	switch (SelectionTransform)
+	{
+	case ESelectionTransform::Translate:
+		Transform = FTransform2D(CurrentPosition - StartPosition);
+		break;
+	case ESelectionTransform::Rotate:
+		{
+			const FVector2D StartOffset = StartPosition - SelectionPivot;
+			const FVector2D CurrentOffset = CurrentPosition - SelectionPivot;
+			const float Angle = FMath::Atan2(CurrentOffset.Y, CurrentOffset.X) - FMath::Atan2(StartOffset.Y, StartOffset.X);
+			Transform = Concatenate(FTransform2D(-SelectionPivot), FTransform2D(FQuat2D(Angle)), FTransform2D(SelectionPivot));
+		}
+		break;
+	case ESelectionTransform::Scale:
+		{
+			const float StartDistance = FVector2D::Distance(StartPosition, SelectionPivot);
+			const float Factor = StartDistance > UE_KINDA_SMALL_NUMBER ? FVector2D::Distance(CurrentPosition, SelectionPivot) / StartDistance : 1.0f;
+			Transform = Concatenate(FTransform2D(-SelectionPivot), FTransform2D(FScale2D(Factor)), FTransform2D(SelectionPivot));
+		}
+		break;
+	}
+
+	// Every point is transformed from its value before the drag, so no error builds up over the drag
+	for (FSplinePointEdit& Edit : DragDelta.Edits)
+	{
+		Edit.NewPoint.Location = Transform.TransformPoint(Edit.OldPoint.Location);
+		Edit.NewPoint.Direction = Transform.TransformVector(Edit.OldPoint.Direction);
+		HitGrid.SetPoint(Edit.Index, ComputeHandleLocations(Edit.NewPoint));
+	}
+
+	OnSplinePointsChanged.ExecuteIfBound(DragDelta);
+	Tessellation.Invalidate();
+	bIsKeyHandleBatchDirty = true;
+}
+
+void SSplineWidgetEditPanel::PaintSplineSimple(const FSlatePaintContext& InPaintContext) const
+{
+	const FGeometry& Geometry = InPaintContext.AllotedGeometry;
+	FSplineTessellation::PaintSimple(InPaintContext, GetSplineData(), Geometry.ToPaintGeometry(Geometry.GetLocalSize() / TransformInfo.Scale, TransformInfo.GetInputToLocal()));
+}
+
+void SSplineWidgetEditPanel::PaintSplineBrush(const FSlatePaintContext& InPaintContext) const
+{
+	// The geometry is kept in input space, so panning and zooming only change the transform it is drawn with
+	const FSlateSpline& SplineRef = GetSplineData();
+	Tessellation.Update(SplineRef, SplineVersion.IsSet() ? TOptional<uint32>(SplineVersion.Get()) : TOptional<uint32>(), InPaintContext.TintColor);
+
+	const FSlateRenderTransform InputToRender = Concatenate(TransformCast<FSlateRenderTransform>(TransformInfo.GetInputToLocal()), InPaintContext.GetRenderTransform());
+	Tessellation.PaintBrush(InPaintContext, BrushResource.GetHandle(), InputToRender, 0.0f);
+}
+
+void SSplineWidgetEditPanel::PaintSplinePoints(const FSlatePaintContext& InPaintContext, const FSlateRect& InCullingRect) const
 {
 	static const FSlateBrush* KeyBrush = FAppStyle::GetBrush("CurveEd.CurveKey");
 	
-	const FSlateSpline& SplineRef = SplineData.Get();
+	const FSlateSpline& SplineRef = GetSplineData();
+	const FSlateRenderTransform& RenderTransform = InPaintContext.GetRenderTransform();
+	const FSlateResourceHandle ResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(*KeyBrush);
+	const FSlateShaderResourceProxy* ResourceProxy = ResourceHandle.GetResourceProxy();
+	const FVector2f StartUV = ResourceProxy ? FVector2f(ResourceProxy->StartUV) : FVector2f::ZeroVector;
+	const FVector2f SizeUV = ResourceProxy ? FVector2f(ResourceProxy->SizeUV) : FVector2f::UnitVector;
+
+	// An idle panel is repainted with the batch it already has, the spline is only visited when something it depends on changed
+	FKeyHandleBatchState& Batch = KeyHandleBatchState;
+	const bool bIsBatchValid = !bIsKeyHandleBatchDirty && SplineVersion.IsSet() && Batch.SplineVersion == SplineVersion.Get()
+		&& Batch.SelectedPointIndex == SelectedPointIndex && Batch.SelectedPoints == SelectedPoints
+		&& Batch.Offset == TransformInfo.Offset && Batch.Scale == TransformInfo.Scale
+		&& Batch.RenderTransform == RenderTransform && Batch.CullingRect == InCullingRect
+		&& Batch.StartUV == StartUV && Batch.SizeUV == SizeUV;
+	if (!bIsBatchValid)
+	{
+		Batch.SplineVersion = SplineVersion.Get(0);
+		Batch.SelectedPointIndex = SelectedPointIndex;
+		Batch.SelectedPoints = SelectedPoints;
+		Batch.Offset = TransformInfo.Offset;
+		Batch.Scale = TransformInfo.Scale;
+		Batch.RenderTransform = RenderTransform;
+		Batch.CullingRect = InCullingRect;
+		Batch.StartUV = StartUV;
+		Batch.SizeUV = SizeUV;
+		bIsKeyHandleBatchDirty = false;
+
+		const FVector2D AbsoluteHalfPointSize = PointSize * 0.5f * InPaintContext.AllotedGeometry.Scale;
+		const FSlateRect ExtendedCullingRect = InCullingRect.ExtendBy(FMargin(AbsoluteHalfPointSize.X, AbsoluteHalfPointSize.Y));
+
+		// Keys sharing a handle sized cell would be drawn on top of each other when zoomed out, so only the first one is kept.
+		// It is also the one picked when clicking the cell.
+		KeyHandleCells.Reset();
+		for (int32 i = 0; i < SplineRef.Points.Num(); ++i)
+		{
+			const FVector2D KeyLocation = TransformInfo.InputToLocal(SplineRef.Points[i].Location);
+			if (i == SelectedPointIndex || !ExtendedCullingRect.ContainsPoint(RenderTransform.TransformPoint(KeyLocation)))
+			{
+				continue;
+			}
 
-	for (int32 i = 0; i < SplineRef.Points.Num(); ++i)
+			const FIntPoint Cell(FMath::FloorToInt(KeyLocation.X / PointSize.X), FMath::FloorToInt(KeyLocation.Y / PointSize.Y));
+			FKeyHandleCell& CellHandle = KeyHandleCells.FindOrAdd(Cell);
+			if (CellHandle.PointIndex == INDEX_NONE)
+			{
+				CellHandle.PointIndex = i;
+			}
+			else
+			{
+				CellHandle.bIsMerged = true;
+			}
+			CellHandle.bIsSelected |= IsPointSelected(i);
+		}
+
+		const FColor KeyColor[2] = { PointColor[false].ToFColorSRGB(), PointColor[true].ToFColorSRGB() };
+
+		KeyHandleVertices.Reset(KeyHandleCells.Num() * 4);
+		KeyHandleIndices.Reset(KeyHandleCells.Num() * 6);
+		for (const TPair<FIntPoint, FKeyHandleCell>& CellHandle : KeyHandleCells)
+		{
+			// Handles standing for several keys are drawn slightly larger
+			const FVector2D KeyLocation = TransformInfo.InputToLocal(SplineRef.Points[CellHandle.Value.PointIndex].Location);
+			const FVector2D HalfSize = PointSize * (CellHandle.Value.bIsMerged ? 0.7f : 0.5f);
+
+			const SlateIndex FirstIndex = KeyHandleVertices.Num();
+			for (int32 Corner = 0; Corner < 4; ++Corner)
+			{
+				const FVector2f CornerUV((Corner & 1) ? 1.0f : 0.0f, (Corner & 2) ? 1.0f : 0.0f);
+				const FVector2D CornerLocation = KeyLocation + HalfSize * (FVector2D(CornerUV) * 2.0f - FVector2D::UnitVector);
+				KeyHandleVertices.Add(FSlateVertex::Make<ESlateVertexRounding::Disabled>(RenderTransform, FVector2f(CornerLocation), StartUV + CornerUV * SizeUV, FVector2f::UnitVector, KeyColor[CellHandle.Value.bIsSelected]));
+			}
+
+			KeyHandleIndices.Append({ FirstIndex, static_cast<SlateIndex>(FirstIndex + 1), static_cast<SlateIndex>(FirstIndex + 2),
+				static_cast<SlateIndex>(FirstIndex + 2), static_cast<SlateIndex>(FirstIndex + 1), static_cast<SlateIndex>(FirstIndex + 3) });
+		}
+	}
+
+	if (KeyHandleIndices.Num() > 0)
 	{
-		const FVector2D KeyLocation = TransformInfo.InputToLocal(SplineRef.Points[i].Location);
-		const FVector2D KeyIconLocation = KeyLocation - PointSize / 2;
+		FSlateDrawElement::MakeCustomVerts(InPaintContext.OutDrawElements, InPaintContext.LayerId, ResourceHandle, KeyHandleVertices, KeyHandleIndices, nullptr, 0, 0, InPaintContext.DrawEffect);
+	}
 
-		const bool IsSelected = SelectedPointIndex == i;
+	// The selected key is never merged or culled away, its tangents stay editable while it is off screen
+	if (SplineRef.Points.IsValidIndex(SelectedPointIndex))
+	{
+		const FSlateSplinePoint& SelectedPoint = SplineRef.Points[SelectedPointIndex];
+		const FVector2D KeyIconLocation = TransformInfo.InputToLocal(SelectedPoint.Location) - PointSize / 2;
 		FSlateDrawElement::MakeBox(
 			InPaintContext.OutDrawElements,
 			InPaintContext.LayerId,
 			InPaintContext.AllotedGeometry.ToPaintGeometry(KeyIconLocation, PointSize),
 			KeyBrush,
 			InPaintContext.DrawEffect,
-			PointColor[IsSelected]
+			PointColor[true]
 		);
 
-		if (IsSelected)
-		{
-			PaintSplineTangent(InPaintContext, SplineRef.Points[i]);
-		}
+		PaintSplineTangent(InPaintContext, SelectedPoint);
 	}
 }
 
@@ -398,6 +711,51 @@ void SSplineWidgetEditPanel::PaintSplineTangent(const FSlatePaintContext& InPain
 	);
 }
 
+void SSplineWidgetEditPanel::PaintMarquee(const FSlatePaintContext& InPaintContext) const
+{
+	if (MarqueePoints.Num() < 2)
+	{
+		return;
+	}
+
+	TArray<FVector2D> LinePoints;
+	if (DragState == EDragState::Marquee)
+	{
+		const FVector2D& Start = MarqueePoints[0];
+		const FVector2D& End = MarqueePoints[1];
+		LinePoints = { Start, FVector2D(End.X, Start.Y), End, FVector2D(Start.X, End.Y), Start };
+	}
+	else
+	{
+		LinePoints = MarqueePoints;
+		LinePoints.Add(MarqueePoints[0]);
+	}
+
+	FSlateDrawElement::MakeLines(
+		InPaintContext.OutDrawElements,
+		InPaintContext.LayerId,
+		InPaintContext.PaintGeometry,
+		LinePoints,
+		InPaintContext.DrawEffect,
+		FLinearColor::White
+	);
+}
+
+void SSplineWidgetEditPanel::PaintStroke(const FSlatePaintContext& InPaintContext) const
+{
+	if (DragState != EDragState::DrawStroke)
+	{
+		return;
+	}
+
+	// Previews the fitted points rather than the raw samples, as they will end up in the spline
+	FSlateSpline StrokeSpline;
+	StrokeFitter.GetPoints(StrokeSpline.Points);
+
+	const FGeometry& Geometry = InPaintContext.AllotedGeometry;
+	FSplineTessellation::PaintSimple(InPaintContext, StrokeSpline, Geometry.ToPaintGeometry(Geometry.GetLocalSize() / TransformInfo.Scale, TransformInfo.GetInputToLocal()));
+}
+
 void SSplineWidgetEditPanel::ComputeTangentPoints(const FSlateSplinePoint& InSplinePoint, FVector2D& OutArrive,
 	FVector2D& OutLeave) const
 {
@@ -443,19 +801,54 @@ TSharedRef<SWidget> SSplineWidgetEditPanel::CreateZoomToFitButton()
 		];
 }
 
+TSharedRef<SWidget> SSplineWidgetEditPanel::CreateDrawStrokeButton()
+{
+	return SNew(SBox)
+		.Padding(FMargin(2, 2, 0, 0))
+		[
+			SNew(SCheckBox)
+			.Style(&FAppStyle::Get().GetWidgetStyle<FCheckBoxStyle>("ToggleButtonCheckbox"))
+			.ToolTipText(LOCTEXT("DrawStrokeToolTip", "Sketch a stroke with the left mouse button to replace the spline"))
+			.IsChecked_Lambda([this]()
+			{
+				return bIsDrawModeActive ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+			{
+				bIsDrawModeActive = NewState == ECheckBoxState::Checked;
+			})
+			[
+				SNew(STextBlock)
+				.Text(LOCTEXT("DrawStroke", "Draw"))
+				.ColorAndOpacity(FSlateColor::UseForeground())
+			]
+		];
+}
+
 bool SSplineWidgetEditPanel::ZoomToFit(bool bFitHorizontal, bool bFitVertical)
 {
     FVector2D InMin(FLT_MAX, FLT_MAX);
     FVector2D InMax(-FLT_MAX, -FLT_MAX);
-    const TArray<FSlateSplinePoint>& Points = SplineData.Get().Points;
+    const FSlateSpline& Spline = GetSplineData();
+    const TArray<FSlateSplinePoint>& Points = Spline.Points;
 
-    // Compute bounds of spline points.
-    for (const FSlateSplinePoint& Point : Points)
+    // Use the bounds of the curve when the curves are up to date, so the parts overshooting the points fit too
+    const FSlateSplineCurves* Curves = OnGetSplineCurves.IsBound() ? OnGetSplineCurves.Execute() : nullptr;
+    if (Curves && Curves->Bounds.bIsValid && Curves->IsBuiltFrom(Spline))
     {
-        InMin.X = FMath::Min(Point.Location.X, InMin.X);
-        InMax.X = FMath::Max(Point.Location.X, InMax.X);
-        InMin.Y = FMath::Min(Point.Location.Y, InMin.Y);
-        InMax.Y = FMath::Max(Point.Location.Y, InMax.Y);
+        InMin = Curves->Bounds.Min;
+        InMax = Curves->Bounds.Max;
+    }
+    else
+    {
+        // Compute bounds of spline points.
+        for (const FSlateSplinePoint& Point : Points)
+        {
+            InMin.X = FMath::Min(Point.Location.X, InMin.X);
+            InMax.X = FMath::Max(Point.Location.X, InMax.X);
+            InMin.Y = FMath::Min(Point.Location.Y, InMin.Y);
+            InMax.Y = FMath::Max(Point.Location.Y, InMax.Y);
+        }
     }
 
     AdjustRangeToFitPoints(InMin.X, InMax.X, Points.Num());
@@ -521,60 +914,88 @@ void SSplineWidgetEditPanel::SetZoomTransform(const FVector2D& InMin, const FVec
     }
 }
 
-bool SSplineWidgetEditPanel::IsWithinBounds(const FVector2D& Position, const FVector2D& Point)
+int SSplineWidgetEditPanel::GetSplinePointUnderPosition(const FVector2D& LocalPosition) const
 {
-	return Position.X > Point.X - 0.5f * PointSize.X &&
-		Position.X < Point.X + 0.5f * PointSize.X &&
-		Position.Y > Point.Y - 0.5f * PointSize.Y &&
-		Position.Y < Point.Y + 0.5f * PointSize.Y;
+	UpdateHitGrid();
+	return HitGrid.FindPoint(FSplineEditHitGrid::EHandle::Key, TransformInfo.LocalToInput(LocalPosition));
 }
 
-int SSplineWidgetEditPanel::GetSplinePointUnderPosition(const FVector2D& LocalPosition) const
+int SSplineWidgetEditPanel::GetSplineTangentUnderPosition(const FVector2D& LocalPosition, bool& bIsArrival) const
 {
-	const FSlateSpline& SplineRef = SplineData.Get();
+	UpdateHitGrid();
+	const FVector2D InputPosition = TransformInfo.LocalToInput(LocalPosition);
+	const int32 ArriveIndex = HitGrid.FindPoint(FSplineEditHitGrid::EHandle::ArriveTangent, InputPosition);
+	const int32 LeaveIndex = HitGrid.FindPoint(FSplineEditHitGrid::EHandle::LeaveTangent, InputPosition);
 
-	for (int32 i = 0; i < SplineRef.Points.Num(); ++i)
+	// The lowest point index wins, and the arrive tangent wins over the leave tangent of the same point
+	if (ArriveIndex != INDEX_NONE && (LeaveIndex == INDEX_NONE || ArriveIndex <= LeaveIndex))
 	{
-		const FVector2D PointLocalLocation = TransformInfo.InputToLocal(SplineRef.Points[i].Location);
-		if (IsWithinBounds(LocalPosition, PointLocalLocation))
-		{
-			return i;
-		}
+		bIsArrival = true;
+		return ArriveIndex;
+	}
+
+	if (LeaveIndex != INDEX_NONE)
+	{
+		bIsArrival = false;
+		return LeaveIndex;
 	}
 
 	return INVALID_INDEX;
 }
 
-int SSplineWidgetEditPanel::GetSplineTangentUnderPosition(const FVector2D& LocalPosition, bool& bIsArrival) const
+FSplineEditHitGrid::FHandleLocations SSplineWidgetEditPanel::ComputeHandleLocations(const FSlateSplinePoint& InSplinePoint) const
 {
-	int TangentIndex  = INVALID_INDEX;
+	// Tangent handles are offset in local space, so their input space locations depend on the zoom
+	FSlateSplinePoint LocalPoint = InSplinePoint;
+	LocalPoint.Location = TransformInfo.InputToLocal(LocalPoint.Location);
+	LocalPoint.Direction = LocalPoint.Direction * TransformInfo.Scale;
+
+	FVector2D ArriveTangent, LeaveTangent;
+	ComputeTangentPoints(LocalPoint, ArriveTangent, LeaveTangent);
+
+	FSplineEditHitGrid::FHandleLocations HandleLocations;
+	HandleLocations[static_cast<int32>(FSplineEditHitGrid::EHandle::Key)] = InSplinePoint.Location;
+	HandleLocations[static_cast<int32>(FSplineEditHitGrid::EHandle::ArriveTangent)] = TransformInfo.LocalToInput(ArriveTangent);
+	HandleLocations[static_cast<int32>(FSplineEditHitGrid::EHandle::LeaveTangent)] = TransformInfo.LocalToInput(LeaveTangent);
+	return HandleLocations;
+}
 
-	const FSlateSpline& SplineRef = SplineData.Get();
-	for (int32 i = 0; i < SplineRef.Points.Num(); ++i)
+const FSlateSpline& SSplineWidgetEditPanel::GetSplineData() const
+{
+	if (OnGetSplineData.IsBound())
 	{
-		FSlateSplinePoint SplinePoint = SplineRef.Points[i];
-		SplinePoint.Location = TransformInfo.InputToLocal(SplinePoint.Location);
-		SplinePoint.Direction = SplinePoint.Direction * TransformInfo.Scale;
-
-		FVector2D ArriveTangent, LeaveTangent;
-		ComputeTangentPoints(SplinePoint, ArriveTangent, LeaveTangent);
-
-		if (IsWithinBounds(LocalPosition, ArriveTangent))
-		{
-			TangentIndex  = i;
-			bIsArrival = true;
-			break;
-		}
-		
-		if (IsWithinBounds(LocalPosition, LeaveTangent))
+		if (const FSlateSpline* SplinePtr = OnGetSplineData.Execute())
 		{
-			TangentIndex  = i;
-			bIsArrival = false;
-			break;
+			return *SplinePtr;
 		}
 	}
-	
-	return TangentIndex;
+	return SplineData.Get();
+}
+
+void SSplineWidgetEditPanel::UpdateHitGrid() const
+{
+	// Handles are a fixed size on screen, so a cell covers less of the input space the further the panel is zoomed in
+	const float CellSize = PointSize.X / TransformInfo.Scale;
+	const TOptional<uint32> Version = SplineVersion.IsSet() ? TOptional<uint32>(SplineVersion.Get()) : TOptional<uint32>();
+	if (!bIsHitGridDirty && HitGrid.GetCellSize() == CellSize && Version.IsSet() && Version == HitGridVersion)
+	{
+		return;
+	}
+
+	// Without a version, only added or removed points are noticed, other external changes have to invalidate the spline data
+	const FSlateSpline& SplineRef = GetSplineData();
+	if (!bIsHitGridDirty && HitGrid.GetCellSize() == CellSize && !Version.IsSet() && HitGrid.GetNumPoints() == SplineRef.Points.Num())
+	{
+		return;
+	}
+
+	HitGrid.Reset(CellSize, SplineRef.Points.Num());
+	for (int32 i = 0; i < SplineRef.Points.Num(); ++i)
+	{
+		HitGrid.SetPoint(i, ComputeHandleLocations(SplineRef.Points[i]));
+	}
+	HitGridVersion = Version;
+	bIsHitGridDirty = false;
 }
 
 void SSplineWidgetEditPanel::CreateContextMenu(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent)
@@ -585,39 +1006,48 @@ void SSplineWidgetEditPanel::CreateContextMenu(const FGeometry& InMyGeometry, co
 	
 	FUIAction AddPointAction = FUIAction(FExecuteAction::CreateLambda([=, this]()
 	{
-		const FScopedTransaction Transaction(LOCTEXT("AddNewSplinePoint", "Add New Spline Point"));
-
 		const FVector2D ScreenMousePosition = InMouseEvent.GetScreenSpacePosition();
 		const FVector2D LocalMousePosition = InMyGeometry.AbsoluteToLocal(ScreenMousePosition);
 		const FSlateSplinePoint NewPoint(TransformInfo.LocalToInput(LocalMousePosition), FVector2D(1.0f, 0.0f));
 
-		FSlateSpline NewSplineInfo = SplineData.Get();
-		SelectedPointIndex = NewSplineInfo.Points.Add(NewPoint);
-
-		OnSplineDataChanged.ExecuteIfBound(NewSplineInfo);
+		const int32 NewPointIndex = GetSplineData().Points.Num();
+		OnSplineEdited.ExecuteIfBound(FSplinePointEdit::MakeInsert(NewPointIndex, NewPoint), LOCTEXT("AddNewSplinePoint", "Add New Spline Point"));
+		InvalidateSplineData();
+		SelectPoint(NewPointIndex, false);
 	}));
 			
 	MenuBuilder.AddMenuEntry(LOCTEXT("AddPoint", "Add point"),
 		LOCTEXT("AddPointToolTip", "Add a new spline point at clicked mouse position"),
 		FSlateIcon(), AddPointAction);
 		
-	if (SelectedPointIndex != -1)
+	if (SelectedPoints.Contains(true))
 	{
 		FUIAction Action = FUIAction(FExecuteAction::CreateLambda([&]()
 		{
-			const FScopedTransaction Transaction(LOCTEXT("DeleteSplinePoint", "Delete Spline Point"));
+			// Removed from the last index down, so the indices of the points still to remove stay valid
+			const FSlateSpline& SplineRef = GetSplineData();
+			FSplineEditDelta Delta;
+			for (int32 i = FMath::Min(SelectedPoints.Num(), SplineRef.Points.Num()) - 1; i >= 0; --i)
+			{
+				if (SelectedPoints[i])
+				{
+					Delta.Edits.Add(FSplinePointEdit::MakeRemove(i, SplineRef.Points[i]));
+				}
+			}
 
-			FSlateSpline SplineRef = SplineData.Get(); 
-			if (SelectedPointIndex != -1 && SplineRef.Points.Num() > SelectedPointIndex)
+			if (!Delta.IsEmpty())
 			{
-				SplineRef.Points.RemoveAt(SelectedPointIndex);
-				SelectedPointIndex = SplineRef.Points.Num() - 1;
-				OnSplineDataChanged.ExecuteIfBound(SplineRef);
+				const int32 NewNumPoints = SplineRef.Points.Num() - Delta.Edits.Num();
+				OnSplineEdited.ExecuteIfBound(Delta, Delta.Edits.Num() == 1
+					? LOCTEXT("DeleteSplinePoint", "Delete Spline Point")
+					: LOCTEXT("DeleteSplinePoints", "Delete Spline Points"));
+				InvalidateSplineData();
+				SelectPoint(NewNumPoints - 1, false);
 			}
 		}));
 		
-		MenuBuilder.AddMenuEntry(LOCTEXT("DeletePoint", "Delete Point"),
-			LOCTEXT("DeletePointToolTip", "Delete the selected point"),
+		MenuBuilder.AddMenuEntry(LOCTEXT("DeletePoint", "Delete Points"),
+			LOCTEXT("DeletePointToolTip", "Delete the selected points"),
 			FSlateIcon(), Action);
 	}
 	MenuBuilder.EndSection();
@@ -0,0 +1,47 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Data/SlateSpline.h"
+
+class IPropertyHandle;
+class USplineWidget;
+struct FSplineEditDelta;
+
+/**
+ * Applies the edits of the spline edit panel to the spline data behind a property handle, with the same notifications as an edit of the property itself.
+ * Finished edits are recorded as undo records holding only the edited points, on every widget whose spline data they change.
+ */
+class WIDGETSPLINESYSTEMEDITOR_API FSplineDataEditor : public TSharedFromThis<FSplineDataEditor>
+{
+public:
+	explicit FSplineDataEditor(const TSharedRef<IPropertyHandle>& InPropertyHandle);
+	~FSplineDataEditor();
+
+	/** Writes interactively edited points straight into the property memory. The post change is sent once per frame. */
+	void ApplyInteractiveEdit(const FSplineEditDelta& Delta);
+
+	/** Applies a finished edit and records it as a single transaction. */
+	void CommitEdit(const FSplineEditDelta& Delta, const FText& TransactionDescription);
+
+	bool IsInteractiveEditActive() const
+	{
+		return bIsInteractiveEditActive;
+	}
+
+	/** Returns the spline data behind the property handle, or null if the handle is no longer valid. */
+	FSlateSpline* GetSplineData() const;
+
+private:
+	/** Sends the change notification coalesced from every interactive write made during the frame. */
+	bool FlushInteractiveChange(float DeltaTime);
+
+	/** Returns the edited widgets and, in the widget designer, the templates they preview, which receive the edited points when the change is posted. */
+	TArray<USplineWidget*> GetEditedWidgets() const;
+
+	TSharedRef<IPropertyHandle> PropertyHandle;
+
+	bool bIsInteractiveEditActive = false;
+	FTSTicker::FDelegateHandle InteractiveChangeHandle;
+};
@@ -0,0 +1,59 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "Data/SlateSplinePoint.h"
+
+/** A single change to the points of a spline. */
+struct WIDGETSPLINESYSTEMEDITOR_API FSplinePointEdit
+{
+	enum class EType : uint8
+	{
+		Modify,
+		Insert,
+		Remove,
+	};
+
+	static FSplinePointEdit MakeModify(int32 InIndex, const FSlateSplinePoint& InOldPoint, const FSlateSplinePoint& InNewPoint)
+	{
+		return { EType::Modify, InIndex, InOldPoint, InNewPoint };
+	}
+
+	static FSplinePointEdit MakeInsert(int32 InIndex, const FSlateSplinePoint& InNewPoint)
+	{
+		return { EType::Insert, InIndex, FSlateSplinePoint(), InNewPoint };
+	}
+
+	static FSplinePointEdit MakeRemove(int32 InIndex, const FSlateSplinePoint& InOldPoint)
+	{
+		return { EType::Remove, InIndex, InOldPoint, FSlateSplinePoint() };
+	}
+
+	EType Type = EType::Modify;
+	int32 Index = INDEX_NONE;
+	FSlateSplinePoint OldPoint;
+	FSlateSplinePoint NewPoint;
+};
+
+/**
+ * The changes made to the points of a spline by one edit, applied in order.
+ * Its size scales with the number of points edited rather than the size of the spline.
+ */
+struct WIDGETSPLINESYSTEMEDITOR_API FSplineEditDelta
+{
+	FSplineEditDelta() = default;
+	FSplineEditDelta(const FSplinePointEdit& InEdit)
+	{
+		Edits.Add(InEdit);
+	}
+
+	void Apply(TArray<FSlateSplinePoint>& Points) const;
+	void Revert(TArray<FSlateSplinePoint>& Points) const;
+
+	bool IsEmpty() const
+	{
+		return Edits.Num() == 0;
+	}
+
+	TArray<FSplinePointEdit> Edits;
+};
@@ -0,0 +1,51 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over the key and tangent handles of a spline, in input space.
+ * Cells are as large as a handle, so a lookup only visits the few cells a handle under the cursor can be in.
+ */
+class FSplineEditHitGrid
+{
+public:
+	enum class EHandle : uint8
+	{
+		Key,
+		ArriveTangent,
+		LeaveTangent,
+		Num
+	};
+
+	static constexpr int32 NumHandles = static_cast<int32>(EHandle::Num);
+
+	/** Handle locations of a single point, indexed by EHandle. */
+	using FHandleLocations = TStaticArray<FVector2D, NumHandles>;
+
+	void Reset(float InCellSize, int32 InNumPoints);
+	void SetPoint(int32 PointIndex, const FHandleLocations& HandleLocations);
+
+	/** Returns the lowest point index whose handle is within half a cell of the position, or INDEX_NONE. */
+	int32 FindPoint(EHandle Handle, const FVector2D& InputPosition) const;
+
+	/** Sets the bit of every point whose handle is inside the box, and clears all others. */
+	void FindPointsInBox(EHandle Handle, const FBox2D& InputBox, TBitArray<>& OutPoints) const;
+
+	/** Sets the bit of every point whose handle is inside the closed polygon, and clears all others. */
+	void FindPointsInPolygon(EHandle Handle, TConstArrayView<FVector2D> InputPolygon, TBitArray<>& OutPoints) const;
+
+	float GetCellSize() const { return CellSize; }
+	int32 GetNumPoints() const { return PointCells[0].Num(); }
+
+private:
+	FIntPoint GetCell(const FVector2D& InputPosition) const;
+
+	float CellSize = 1.0f;
+
+	/** Cell of each handle of each point, indexed by EHandle then point index. */
+	TStaticArray<TArray<FIntPoint>, NumHandles> PointCells;
+	TStaticArray<TArray<FVector2D>, NumHandles> PointLocations;
+	TStaticArray<TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>>, NumHandles> Cells;
+};
@@ -4,9 +4,23 @@
 
 #include "IDetailCustomization.h"
 
+class FSplineDataEditor;
+class SSplineWidgetEditPanel;
+class USplineWidget;
+
 class FSplineWidgetDetailCustomization final : public IDetailCustomization
 {
 public:
 	static TSharedRef<IDetailCustomization> MakeInstance();
 	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailLayout) override;
+
+private:
+	/** Keeps the edit panel in sync with changes made outside of it. */
+	void OnSplineDataChanged();
+
+	TWeakObjectPtr<USplineWidget> SplineWidget;
+	TSharedPtr<SSplineWidgetEditPanel> EditPanel;
+
+	/** Applies the edits of the panel to the spline data property and records them for undo. */
+	TSharedPtr<FSplineDataEditor> SplineDataEditor;
 };
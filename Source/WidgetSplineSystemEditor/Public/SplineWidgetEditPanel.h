@@ -3,18 +3,38 @@
 #pragma once
 #include "Data/SlatePaintContext.h"
 #include "Data/SlateSpline.h"
-
-DECLARE_DELEGATE_OneParam(FOnSplineDataChanged, const FSlateSpline&)
-
-class WIDGETSPLINESYSTEMEDITOR_API SSplineWidgetEditPanel : public SCompoundWidget
+#include "Data/SlateSplineCurves.h"
+#include "EditorUndoClient.h"
+#include "SplineEditDelta.h"
+#include "SplineEditHitGrid.h"
+#include "Data/SplineStrokeFitter.h"
+#include "Slate/SplineBrushResource.h"
+#include "Slate/SplineTessellation.h"
+
+/** Fired once per finished edit with the changed points and a description for the undo history. */
+DECLARE_DELEGATE_TwoParams(FOnSplineEdited, const FSplineEditDelta&, const FText&)
+/** Fired for every step of an interactive edit with the points modified since it started, before the edit is finished. */
+DECLARE_DELEGATE_OneParam(FOnSplinePointsChanged, const FSplineEditDelta&)
+
+class WIDGETSPLINESYSTEMEDITOR_API SSplineWidgetEditPanel : public SCompoundWidget, public FSelfRegisteringEditorUndoClient
 {
 public:
 	SLATE_BEGIN_ARGS(SSplineWidgetEditPanel)
 	: _SplineData()
-	, _OnSplineDataChanged()
+	, _OnGetSplineData()
+	, _SplineVersion()
+	, _OnSplineEdited()
+	, _OnSplinePointsChanged()
+	, _OnGetSplineCurves()
 		{ }
 		SLATE_ATTRIBUTE(FSlateSpline, SplineData)
-		SLATE_EVENT(FOnSplineDataChanged, OnSplineDataChanged)
+		/** Read in place of SplineData while bound, so looking up and drawing points does not copy the spline. */
+		SLATE_EVENT(FOnGetSpline, OnGetSplineData)
+		SLATE_ATTRIBUTE(uint32, SplineVersion)
+		SLATE_EVENT(FOnSplineEdited, OnSplineEdited)
+		SLATE_EVENT(FOnSplinePointsChanged, OnSplinePointsChanged)
+		/** Returns the curves built from the spline data, whose bounds zoom to fit uses when they are up to date. */
+		SLATE_EVENT(FOnGetSplineCurves, OnGetSplineCurves)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
@@ -29,32 +49,81 @@ public:
 	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
 	virtual void OnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent) override;
 
+	virtual void PostUndo(bool bSuccess) override;
+	virtual void PostRedo(bool bSuccess) override;
+
+	/** Must be called when the spline data is changed by anything other than this panel. */
+	void InvalidateSplineData();
+
 protected:
 	virtual void PaintSplineSimple(const FSlatePaintContext& InPaintContext) const;
 	virtual void PaintSplineBrush(const FSlatePaintContext& InPaintContext) const;
-	virtual void PaintSplinePoints(const FSlatePaintContext& InPaintContext) const;
+	virtual void PaintSplinePoints(const FSlatePaintContext& InPaintContext, const FSlateRect& InCullingRect) const;
 	virtual void PaintSplineTangent(const FSlatePaintContext& InPaintContext, FSlateSplinePoint SplinePoint) const;
+	virtual void PaintMarquee(const FSlatePaintContext& InPaintContext) const;
+	virtual void PaintStroke(const FSlatePaintContext& InPaintContext) const;
 
 	virtual void ComputeTangentPoints(const FSlateSplinePoint& InSplinePoint, FVector2D& OutArrive, FVector2D& OutLeave) const;
 	
 	TSharedRef<SWidget> CreateZoomToFitButton();
+	TSharedRef<SWidget> CreateDrawStrokeButton();
 	bool ZoomToFit(bool bFitHorizontal, bool bFitVertical);
 	static void AdjustRangeToFitPoints(double& InMin, double& InMax, int32 PointsCount);
 	void SetZoomTransform(const FVector2D& InMin, const FVector2D& InMax, const FVector2D& LocalSize,
 	                      bool bFitHorizontal,
 	                      bool bFitVertical);
 
-	static bool IsWithinBounds(const FVector2D& Position, const FVector2D& Point);
 	int GetSplinePointUnderPosition(const FVector2D& LocalPosition) const;
 	int GetSplineTangentUnderPosition(const FVector2D& LocalPosition, bool& bIsArrival) const;
 
+	/** Returns the input space locations of the key and tangent handles of a point at the current zoom. */
+	FSplineEditHitGrid::FHandleLocations ComputeHandleLocations(const FSlateSplinePoint& InSplinePoint) const;
+
+	/** Returns the spline from OnGetSplineData if it is bound and returns one, otherwise from SplineData. */
+	const FSlateSpline& GetSplineData() const;
+
+	/** Rebuilds the hit grid if the spline was changed externally or its version changed, or the zoom changed. */
+	void UpdateHitGrid() const;
+
 	void CreateContextMenu(const FGeometry& InMyGeometry, const FPointerEvent& InMouseEvent);
 
+	/** Commits the points edited by the current drag, if any. */
+	void FinishDrag();
+
+	bool IsPointSelected(int32 PointIndex) const
+	{
+		return SelectedPoints.IsValidIndex(PointIndex) && SelectedPoints[PointIndex];
+	}
+
+	/** Makes the point the active one, either alone or added to the current selection. */
+	void SelectPoint(int32 PointIndex, bool bAddToSelection);
+	void ClearSelection();
+
+	/** Replaces, extends or reduces the selection with the points inside the marquee or lasso. */
+	void ApplyMarqueeSelection(bool bAddToSelection, bool bRemoveFromSelection);
+
+	enum class ESelectionTransform
+	{
+		Translate,
+		Rotate,
+		Scale,
+	};
+
+	/** Records the selected points as they are before the drag, and the pivot to rotate and scale them around. */
+	void BeginSelectionTransform(ESelectionTransform InTransform);
+
+	/** Transforms every selected point from where it was before the drag, reporting all of them at once. */
+	void UpdateSelectionTransform(const FVector2D& LocalMousePosition);
+
 protected:
 	static constexpr int32 INVALID_INDEX = -1;
 	
 	TAttribute<FSlateSpline> SplineData;
-	FOnSplineDataChanged OnSplineDataChanged;
+	FOnGetSpline OnGetSplineData;
+	TAttribute<uint32> SplineVersion;
+	FOnSplineEdited OnSplineEdited;
+	FOnSplinePointsChanged OnSplinePointsChanged;
+	FOnGetSplineCurves OnGetSplineCurves;
 
 	struct FSplineEditPanelTransform
 	{
@@ -70,9 +139,16 @@ protected:
 		{
 			return (Input - Offset) * Scale;
 		}
+
+		FSlateLayoutTransform GetInputToLocal() const
+		{
+			return FSlateLayoutTransform(Scale, -Offset * Scale);
+		}
 	} TransformInfo;
 
+	/** The point whose tangents are shown and edited. Always part of the selection, if valid. */
 	int SelectedPointIndex = 0;
+	TBitArray<> SelectedPoints;
 	bool bIsSelectedTangentArrival = false;
 	bool bIsPanelFocused = false;
 
@@ -80,11 +156,67 @@ protected:
 	{
 		None,
 		PreDrag,
-		DragKey,
+		DragSelection,
 		DragTangent,
+		Marquee,
+		Lasso,
+		DrawStroke,
 		Pan,
 	} DragState = EDragState::None;
 
 	FVector2D LastMouseDownLocation;
-	FVector2D PreDragPointLocation;
+
+	/** Points edited by the current drag, holding their value from before the drag and their current one. */
+	FSplineEditDelta DragDelta;
+	ESelectionTransform SelectionTransform = ESelectionTransform::Translate;
+	FVector2D SelectionPivot = FVector2D::ZeroVector;
+
+	/** Corners of the marquee, or the path of the lasso, in local space. */
+	TArray<FVector2D> MarqueePoints;
+
+	/** While set, dragging with the left button sketches a stroke that replaces the spline. */
+	bool bIsDrawModeActive = false;
+	FSplineStrokeFitter StrokeFitter;
+
+	/** Brush geometry in input space, the pan and zoom are applied when painting it. */
+	mutable FSplineTessellation Tessellation;
+	mutable FSplineBrushResource BrushResource;
+
+	mutable FSplineEditHitGrid HitGrid;
+	mutable bool bIsHitGridDirty = true;
+
+	/** Spline version the hit grid was built for. While it matches, the grid is reused without reading the spline. */
+	mutable TOptional<uint32> HitGridVersion;
+
+	/** Key handle quads, drawn as a single batch. */
+	mutable TArray<FSlateVertex> KeyHandleVertices;
+	mutable TArray<SlateIndex> KeyHandleIndices;
+
+	/** What the key handle batch was built for. It is rebuilt once the spline version, the selection, the zoom or where the panel is drawn changes. */
+	struct FKeyHandleBatchState
+	{
+		uint32 SplineVersion = 0;
+		int32 SelectedPointIndex = INDEX_NONE;
+		TBitArray<> SelectedPoints;
+		FVector2D Offset = FVector2D::ZeroVector;
+		float Scale = 1.0f;
+		FSlateRenderTransform RenderTransform;
+		FSlateRect CullingRect;
+		FVector2f StartUV = FVector2f::ZeroVector;
+		FVector2f SizeUV = FVector2f::UnitVector;
+	};
+	mutable FKeyHandleBatchState KeyHandleBatchState;
+
+	/** Set when points move without the spline version changing, as they do while dragging. */
+	mutable bool bIsKeyHandleBatchDirty = true;
+
+	struct FKeyHandleCell
+	{
+		int32 PointIndex = INDEX_NONE;
+		bool bIsMerged = false;
+		bool bIsSelected = false;
+	};
+
+	/** Key handle drawn in each handle sized cell of the panel. */
+	mutable TMap<FIntPoint, FKeyHandleCell> KeyHandleCells;
 };
@@ -0,0 +1,127 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSpline.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlateSplineSerializationBenchmark, "WidgetSplineSystem.Serialization.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace SlateSplineSerializationTest
+{
+	constexpr int32 NumPoints = 100000;
+	constexpr int32 NumLoads = 10;
+
+	FSlateSpline MakeSpline(ESlateSplineQuantization Quantization)
+	{
+		FRandomStream RandomStream(1234);
+		FSlateSpline Spline;
+		Spline.Quantization = Quantization;
+		Spline.Points.Reset(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			Spline.Points.Emplace(
+				FVector2D(RandomStream.FRandRange(-5000.0f, 5000.0f), RandomStream.FRandRange(-5000.0f, 5000.0f)),
+				FVector2D(RandomStream.FRandRange(-500.0f, 500.0f), RandomStream.FRandRange(-500.0f, 500.0f)),
+				RandomStream.FRand(),
+				FLinearColor::MakeRandomColor());
+		}
+		return Spline;
+	}
+
+	/** Returns the average time, in milliseconds, to load the spline from the bytes. */
+	template<typename FLoadFunc>
+	double MeasureLoad(const TArray<uint8>& Bytes, const FCustomVersionContainer& CustomVersions, FSlateSpline& OutSpline, FLoadFunc&& Load)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < NumLoads; i++)
+		{
+			FMemoryReader Reader(Bytes, true);
+			Reader.SetCustomVersions(CustomVersions);
+			OutSpline = FSlateSpline();
+			Load(Reader, OutSpline);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumLoads;
+	}
+}
+
+bool FSlateSplineSerializationBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SlateSplineSerializationTest;
+
+	UScriptStruct* SplineStruct = FSlateSpline::StaticStruct();
+	const auto& SaveTagged = [SplineStruct](FArchive& Ar, FSlateSpline& Spline)
+	{
+		SplineStruct->SerializeTaggedProperties(Ar, reinterpret_cast<uint8*>(&Spline), SplineStruct, nullptr);
+	};
+	const auto& SaveBulk = [](FArchive& Ar, FSlateSpline& Spline)
+	{
+		Spline.Serialize(Ar);
+	};
+
+	FSlateSpline Spline = MakeSpline(ESlateSplineQuantization::None);
+
+	// Tagged properties, the format used before the native serializer
+	TArray<uint8> TaggedBytes;
+	FMemoryWriter TaggedWriter(TaggedBytes, true);
+	SaveTagged(TaggedWriter, Spline);
+
+	FSlateSpline TaggedSpline;
+	const double TaggedLoadTime = MeasureLoad(TaggedBytes, TaggedWriter.GetCustomVersions(), TaggedSpline, SaveTagged);
+
+	// Contiguous blocks at full precision, which must load back exactly
+	TArray<uint8> BulkBytes;
+	FMemoryWriter BulkWriter(BulkBytes, true);
+	SaveBulk(BulkWriter, Spline);
+
+	FSlateSpline BulkSpline;
+	const double BulkLoadTime = MeasureLoad(BulkBytes, BulkWriter.GetCustomVersions(), BulkSpline, SaveBulk);
+
+	if (TestEqual(TEXT("Bulk point count"), BulkSpline.Points.Num(), Spline.Points.Num()))
+	{
+		bool bIsLossless = true;
+		for (int32 i = 0; i < NumPoints && bIsLossless; i++)
+		{
+			const FSlateSplinePoint& Expected = Spline.Points[i];
+			const FSlateSplinePoint& Actual = BulkSpline.Points[i];
+			bIsLossless = Expected.Location == Actual.Location && Expected.Direction == Actual.Direction
+				&& Expected.Width == Actual.Width && Expected.Color == Actual.Color;
+		}
+		TestTrue(TEXT("Bulk round trip is lossless"), bIsLossless);
+	}
+
+	// 16 bit fixed point, which must stay within one step of the bounds
+	FSlateSpline QuantizedSpline = MakeSpline(ESlateSplineQuantization::Fixed16);
+	TArray<uint8> QuantizedBytes;
+	FMemoryWriter QuantizedWriter(QuantizedBytes, true);
+	SaveBulk(QuantizedWriter, QuantizedSpline);
+
+	FSlateSpline LoadedQuantizedSpline;
+	const double QuantizedLoadTime = MeasureLoad(QuantizedBytes, QuantizedWriter.GetCustomVersions(), LoadedQuantizedSpline, SaveBulk);
+
+	if (TestEqual(TEXT("Quantized point count"), LoadedQuantizedSpline.Points.Num(), QuantizedSpline.Points.Num()))
+	{
+		constexpr double LocationTolerance = 10000.0 / MAX_uint16;
+		constexpr double DirectionTolerance = 1000.0 / MAX_uint16;
+		bool bIsWithinTolerance = true;
+		for (int32 i = 0; i < NumPoints && bIsWithinTolerance; i++)
+		{
+			const FSlateSplinePoint& Expected = QuantizedSpline.Points[i];
+			const FSlateSplinePoint& Actual = LoadedQuantizedSpline.Points[i];
+			bIsWithinTolerance = Expected.Location.Equals(Actual.Location, LocationTolerance)
+				&& Expected.Direction.Equals(Actual.Direction, DirectionTolerance);
+		}
+		TestTrue(TEXT("Quantized round trip is within one step"), bIsWithinTolerance);
+	}
+
+	AddInfo(FString::Printf(TEXT("%d points. Tagged: %d bytes, %.2f ms per load. Bulk: %d bytes, %.2f ms per load. Fixed16: %d bytes, %.2f ms per load."),
+		NumPoints, TaggedBytes.Num(), TaggedLoadTime, BulkBytes.Num(), BulkLoadTime, QuantizedBytes.Num(), QuantizedLoadTime));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,343 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "SplineBenchmark.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace SplineBenchmark
+{
+	static constexpr EShape Shapes[] = { EShape::Straight, EShape::Gentle, EShape::CuspHeavy, EShape::HugeTangents };
+	static constexpr int32 PointCounts[] = { 10, 100, 1000, 10000, 100000, 1000000 };
+	static constexpr float PointSpacing = 10.0f;
+
+	/** Untimed runs whose allocations are counted. The fewest are kept, as allocations of other threads only ever add to the count. */
+	static constexpr int32 NumCountedRuns = 3;
+
+	/** Returns the number of allocations made so far, or INDEX_NONE if the allocator does not count them. */
+	static int64 GetNumAllocationCalls()
+	{
+#if STATS
+		// Kept by the allocator itself, so they are counted whether or not GMalloc is inlined
+		return static_cast<int64>(FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls);
+#else
+		return INDEX_NONE;
+#endif
+	}
+
+	static int32 GetMaxPoints()
+	{
+		int32 MaxPoints = PointCounts[UE_ARRAY_COUNT(PointCounts) - 1];
+		FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkMaxPoints="), MaxPoints);
+		return MaxPoints;
+	}
+
+	static double GetMinSeconds()
+	{
+		double MinSeconds = 0.05;
+		FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkMinSeconds="), MinSeconds);
+		return MinSeconds;
+	}
+
+	static double GetMaxSecondsPerRun()
+	{
+		double MaxSecondsPerRun = 5.0;
+		FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkMaxSecondsPerRun="), MaxSecondsPerRun);
+		return MaxSecondsPerRun;
+	}
+
+	static FString GetResultsDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Automation") / TEXT("WidgetSplineSystem");
+	}
+
+	static FString GetBaselineDir()
+	{
+		FString BaselineDir = GetResultsDir() / TEXT("Baseline");
+		FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkBaseline="), BaselineDir);
+		return BaselineDir;
+	}
+
+	static TSharedRef<FJsonObject> ToJson(const FSplineBenchmarkResult& Result)
+	{
+		const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("Benchmark"), Result.Benchmark);
+		Object->SetStringField(TEXT("Shape"), Result.Shape);
+		Object->SetNumberField(TEXT("NumPoints"), Result.NumPoints);
+		Object->SetNumberField(TEXT("NanosecondsPerOp"), Result.NanosecondsPerOp);
+		Object->SetNumberField(TEXT("OpsPerRun"), Result.OpsPerRun);
+		Object->SetNumberField(TEXT("NumRuns"), Result.NumRuns);
+		Object->SetNumberField(TEXT("AllocationsPerRun"), Result.AllocationsPerRun);
+		Object->SetNumberField(TEXT("VerticesPerRun"), Result.VerticesPerRun);
+		return Object;
+	}
+
+	static FSplineBenchmarkResult FromJson(const FJsonObject& Object)
+	{
+		FSplineBenchmarkResult Result;
+		Result.Benchmark = Object.GetStringField(TEXT("Benchmark"));
+		Result.Shape = Object.GetStringField(TEXT("Shape"));
+		Result.NumPoints = Object.GetIntegerField(TEXT("NumPoints"));
+		Result.NanosecondsPerOp = Object.GetNumberField(TEXT("NanosecondsPerOp"));
+		Result.OpsPerRun = static_cast<int64>(Object.GetNumberField(TEXT("OpsPerRun")));
+		Result.NumRuns = Object.GetIntegerField(TEXT("NumRuns"));
+		Result.AllocationsPerRun = static_cast<int64>(Object.GetNumberField(TEXT("AllocationsPerRun")));
+		Result.VerticesPerRun = static_cast<int64>(Object.GetNumberField(TEXT("VerticesPerRun")));
+		return Result;
+	}
+
+	const TCHAR* LexToString(EShape Shape)
+	{
+		switch (Shape)
+		{
+		case EShape::Straight:
+			return TEXT("Straight");
+		case EShape::Gentle:
+			return TEXT("Gentle");
+		case EShape::CuspHeavy:
+			return TEXT("CuspHeavy");
+		case EShape::HugeTangents:
+			return TEXT("HugeTangents");
+		}
+		return TEXT("Unknown");
+	}
+
+	TConstArrayView<EShape> GetShapes()
+	{
+		return Shapes;
+	}
+
+	TArray<int32> GetPointCounts()
+	{
+		const int32 MaxPoints = GetMaxPoints();
+		TArray<int32> Counts;
+		for (const int32 NumPoints : PointCounts)
+		{
+			if (NumPoints <= MaxPoints)
+			{
+				Counts.Add(NumPoints);
+			}
+		}
+		return Counts;
+	}
+
+	FSlateSpline MakeSpline(EShape Shape, int32 NumPoints)
+	{
+		FRandomStream RandomStream(1234);
+		FSlateSpline Spline;
+		Spline.Brush.SetImageSize(FVector2D(8.0f));
+		Spline.Points.Reserve(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			const float X = i * PointSpacing;
+			switch (Shape)
+			{
+			case EShape::Straight:
+				Spline.Points.Emplace(FVector2D(X, 0.0f), FVector2D(PointSpacing, 0.0f));
+				break;
+			case EShape::Gentle:
+				Spline.Points.Emplace(FVector2D(X, 50.0f * FMath::Sin(i * 0.1f)), FVector2D(PointSpacing, 5.0f * FMath::Cos(i * 0.1f)));
+				break;
+			case EShape::CuspHeavy:
+				Spline.Points.Emplace(FVector2D(X, (i % 2) * 40.0f), FVector2D(-3.0f * PointSpacing, (i % 2 ? 1.0f : -1.0f) * 80.0f));
+				break;
+			case EShape::HugeTangents:
+			{
+				const float Angle = RandomStream.FRandRange(0.0f, UE_TWO_PI);
+				Spline.Points.Emplace(FVector2D(X, RandomStream.FRandRange(-100.0f, 100.0f)), FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * PointSpacing * 1000.0f);
+				break;
+			}
+			}
+		}
+		return Spline;
+	}
+}
+
+FString FSplineBenchmarkResult::GetKey() const
+{
+	return FString::Printf(TEXT("%s/%s/%d"), *Benchmark, *Shape, NumPoints);
+}
+
+FSplineBenchmarkReport::FSplineBenchmarkReport(const FString& InName)
+	: Name(InName)
+{
+}
+
+bool FSplineBenchmarkReport::ShouldMeasure(const FString& Benchmark, SplineBenchmark::EShape Shape, int32 NumPoints)
+{
+	// Point counts are measured in increasing order, so the last result of the benchmark and shape has the most points
+	const FString ShapeName = SplineBenchmark::LexToString(Shape);
+	const int32 PreviousIndex = Results.FindLastByPredicate([&](const FSplineBenchmarkResult& Result)
+	{
+		return Result.Benchmark == Benchmark && Result.Shape == ShapeName && Result.NumPoints < NumPoints;
+	});
+	if (PreviousIndex == INDEX_NONE)
+	{
+		return true;
+	}
+
+	const FSplineBenchmarkResult& Previous = Results[PreviousIndex];
+	const double PreviousSecondsPerRun = Previous.NanosecondsPerOp * Previous.OpsPerRun * 1.0e-9;
+	const double ExpectedSecondsPerRun = PreviousSecondsPerRun * NumPoints / Previous.NumPoints;
+	if (ExpectedSecondsPerRun <= SplineBenchmark::GetMaxSecondsPerRun())
+	{
+		return true;
+	}
+
+	Skipped.Add(FString::Printf(TEXT("%s/%s/%d"), *Benchmark, *ShapeName, NumPoints));
+	return false;
+}
+
+FSplineBenchmarkResult& FSplineBenchmarkReport::Measure(const FString& Benchmark, SplineBenchmark::EShape Shape, int32 NumPoints, TFunctionRef<int64()> Run)
+{
+	FSplineBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+	Result.Benchmark = Benchmark;
+	Result.Shape = SplineBenchmark::LexToString(Shape);
+	Result.NumPoints = NumPoints;
+
+	// The first run warms the caches and is not timed
+	Result.OpsPerRun = Run();
+
+	const double MinSeconds = SplineBenchmark::GetMinSeconds();
+	const double StartTime = FPlatformTime::Seconds();
+	double ElapsedSeconds = 0.0;
+	int64 TotalOps = 0;
+	do
+	{
+		TotalOps += Run();
+		Result.NumRuns++;
+		ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+	while (ElapsedSeconds < MinSeconds);
+	Result.NanosecondsPerOp = TotalOps > 0 ? ElapsedSeconds * 1.0e9 / TotalOps : 0.0;
+
+	if (SplineBenchmark::GetNumAllocationCalls() == INDEX_NONE)
+	{
+		Result.AllocationsPerRun = INDEX_NONE;
+	}
+	else
+	{
+		Result.AllocationsPerRun = TNumericLimits<int64>::Max();
+		for (int32 i = 0; i < SplineBenchmark::NumCountedRuns; ++i)
+		{
+			const int64 NumCallsBefore = SplineBenchmark::GetNumAllocationCalls();
+			Run();
+			Result.AllocationsPerRun = FMath::Min(Result.AllocationsPerRun, SplineBenchmark::GetNumAllocationCalls() - NumCallsBefore);
+		}
+	}
+
+	return Result;
+}
+
+void FSplineBenchmarkReport::Finish(FAutomationTestBase& Test) const
+{
+	const FString ResultsDir = SplineBenchmark::GetResultsDir();
+
+	FString Csv = TEXT("Benchmark,Shape,NumPoints,NanosecondsPerOp,OpsPerRun,NumRuns,AllocationsPerRun,VerticesPerRun\n");
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for (const FSplineBenchmarkResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%.3f,%lld,%d,%lld,%lld\n"), *Result.Benchmark, *Result.Shape, Result.NumPoints,
+			Result.NanosecondsPerOp, Result.OpsPerRun, Result.NumRuns, Result.AllocationsPerRun, Result.VerticesPerRun);
+		JsonResults.Add(MakeShared<FJsonValueObject>(SplineBenchmark::ToJson(Result)));
+	}
+
+	const TSharedRef<FJsonObject> JsonReport = MakeShared<FJsonObject>();
+	JsonReport->SetStringField(TEXT("Name"), Name);
+	JsonReport->SetArrayField(TEXT("Results"), JsonResults);
+	FString Json;
+	FJsonSerializer::Serialize(JsonReport, TJsonWriterFactory<>::Create(&Json));
+
+	const FString CsvPath = ResultsDir / Name + TEXT(".csv");
+	const FString JsonPath = ResultsDir / Name + TEXT(".json");
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath) || !FFileHelper::SaveStringToFile(Json, *JsonPath))
+	{
+		Test.AddWarning(FString::Printf(TEXT("Could not write the results to %s"), *ResultsDir));
+	}
+	Test.AddInfo(FString::Printf(TEXT("%d results written to %s"), Results.Num(), *JsonPath));
+	if (SplineBenchmark::GetNumAllocationCalls() == INDEX_NONE)
+	{
+		Test.AddInfo(TEXT("Allocations are not counted without stats, AllocationsPerRun is -1"));
+	}
+	if (Skipped.Num() > 0)
+	{
+		Test.AddInfo(FString::Printf(TEXT("Skipped over -SplineBenchmarkMaxSecondsPerRun: %s"), *FString::Join(Skipped, TEXT(", "))));
+	}
+
+	const FString BaselinePath = SplineBenchmark::GetBaselineDir() / Name + TEXT(".json");
+	if (FParse::Param(FCommandLine::Get(), TEXT("SplineBenchmarkUpdateBaseline")))
+	{
+		FFileHelper::SaveStringToFile(Json, *BaselinePath);
+		Test.AddInfo(FString::Printf(TEXT("Baseline updated at %s"), *BaselinePath));
+		return;
+	}
+
+	FString BaselineJson;
+	TSharedPtr<FJsonObject> BaselineReport;
+	if (!FFileHelper::LoadFileToString(BaselineJson, *BaselinePath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineJson), BaselineReport) || !BaselineReport.IsValid())
+	{
+		Test.AddInfo(FString::Printf(TEXT("No baseline at %s, run with -SplineBenchmarkUpdateBaseline to store one"), *BaselinePath));
+		return;
+	}
+
+	TMap<FString, FSplineBenchmarkResult> Baseline;
+	for (const TSharedPtr<FJsonValue>& Value : BaselineReport->GetArrayField(TEXT("Results")))
+	{
+		const FSplineBenchmarkResult BaselineResult = SplineBenchmark::FromJson(*Value->AsObject());
+		Baseline.Add(BaselineResult.GetKey(), BaselineResult);
+	}
+
+	double Tolerance = 0.2;
+	FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkTolerance="), Tolerance);
+	double AllocationTolerance = 0.1;
+	FParse::Value(FCommandLine::Get(), TEXT("SplineBenchmarkAllocationTolerance="), AllocationTolerance);
+	const bool bFailOnRegression = FParse::Param(FCommandLine::Get(), TEXT("SplineBenchmarkFailOnRegression"));
+	const auto& ReportRegression = [&Test, bFailOnRegression](const FString& Message)
+	{
+		if (bFailOnRegression)
+		{
+			Test.AddError(Message);
+		}
+		else
+		{
+			Test.AddWarning(Message);
+		}
+	};
+
+	// Timings are noisy, so only slowdowns past the tolerance count.
+	// Allocations of other threads can slip into the count, so at least one more than the baseline is allowed, and counts not measured are skipped.
+	int32 NumCompared = 0;
+	for (const FSplineBenchmarkResult& Result : Results)
+	{
+		const FSplineBenchmarkResult* BaselineResult = Baseline.Find(Result.GetKey());
+		if (!BaselineResult)
+		{
+			continue;
+		}
+		NumCompared++;
+
+		if (Result.NanosecondsPerOp > BaselineResult->NanosecondsPerOp * (1.0 + Tolerance))
+		{
+			ReportRegression(FString::Printf(TEXT("%s: %.1f ns/op, baseline %.1f ns/op"), *Result.GetKey(), Result.NanosecondsPerOp, BaselineResult->NanosecondsPerOp));
+		}
+		if (Result.AllocationsPerRun != INDEX_NONE && BaselineResult->AllocationsPerRun != INDEX_NONE
+			&& Result.AllocationsPerRun > BaselineResult->AllocationsPerRun + FMath::Max(BaselineResult->AllocationsPerRun * AllocationTolerance, 1.0))
+		{
+			ReportRegression(FString::Printf(TEXT("%s: %lld allocations per run, baseline %lld"), *Result.GetKey(), Result.AllocationsPerRun, BaselineResult->AllocationsPerRun));
+		}
+		if (Result.VerticesPerRun != BaselineResult->VerticesPerRun)
+		{
+			Test.AddWarning(FString::Printf(TEXT("%s: %lld vertices per run, baseline %lld"), *Result.GetKey(), Result.VerticesPerRun, BaselineResult->VerticesPerRun));
+		}
+	}
+	Test.AddInfo(FString::Printf(TEXT("%d of %d results compared against %s"), NumCompared, Results.Num(), *BaselinePath));
+}
@@ -0,0 +1,99 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/SlateSpline.h"
+
+class FAutomationTestBase;
+
+/**
+ * Shared setup of the spline benchmarks. Every benchmark runs across the same point counts and curve shapes.
+ * Command line options:
+ *	-SplineBenchmarkMaxPoints=N			Skips point counts above N, 1M by default
+ *	-SplineBenchmarkMinSeconds=S		Time each measurement is repeated for, 0.05 by default
+ *	-SplineBenchmarkMaxSecondsPerRun=S	Skips point counts expected to take longer than S per run, 5 by default
+ *	-SplineBenchmarkBaseline=Dir		Directory of the baseline results, Saved/Automation/WidgetSplineSystem/Baseline by default
+ *	-SplineBenchmarkTolerance=F			Slowdown over the baseline reported as a regression, 0.2 by default
+ *	-SplineBenchmarkAllocationTolerance=F	Allocations over the baseline reported as a regression, 0.1 by default and at least one
+ *	-SplineBenchmarkUpdateBaseline		Stores the results as the new baseline
+ *	-SplineBenchmarkFailOnRegression	Fails the test on regressions instead of warning
+ */
+namespace SplineBenchmark
+{
+	enum class EShape : uint8
+	{
+		/** Points on a line, with tangents along it. */
+		Straight,
+		/** Sine wave with tangents following it. */
+		Gentle,
+		/** Zigzag with tangents against the chords, so every segment loops back on itself. */
+		CuspHeavy,
+		/** Random tangents a thousand times longer than the segments. */
+		HugeTangents
+	};
+
+	const TCHAR* LexToString(EShape Shape);
+
+	TConstArrayView<EShape> GetShapes();
+
+	/** Point counts from 10 to 1M, up to -SplineBenchmarkMaxPoints. */
+	TArray<int32> GetPointCounts();
+
+	/** Builds a spline of the shape, the same for every run. */
+	FSlateSpline MakeSpline(EShape Shape, int32 NumPoints);
+}
+
+/** One measurement, written as a row of the results. */
+struct FSplineBenchmarkResult
+{
+	FString Benchmark;
+	FString Shape;
+	int32 NumPoints = 0;
+
+	double NanosecondsPerOp = 0.0;
+	int64 OpsPerRun = 0;
+	int32 NumRuns = 0;
+
+	/**
+	 * Heap allocations of one run, the fewest of a few untimed runs, counted by the allocator for the whole process.
+	 * INDEX_NONE in builds without stats, where the allocator does not count them.
+	 */
+	int64 AllocationsPerRun = 0;
+
+	/** Vertices emitted by one run, for benchmarks that build geometry. */
+	int64 VerticesPerRun = 0;
+
+	/** Identifies the measurement in the baseline. */
+	FString GetKey() const;
+};
+
+/**
+ * Results of one benchmark test. Written to Saved/Automation/WidgetSplineSystem as CSV and JSON when finished,
+ * and compared against the results stored as the baseline.
+ */
+class FSplineBenchmarkReport
+{
+public:
+	explicit FSplineBenchmarkReport(const FString& InName);
+
+	/**
+	 * Returns whether a run with this many points is expected to fit -SplineBenchmarkMaxSecondsPerRun, extrapolated from
+	 * the last measurement of the benchmark with fewer points. Subdividing huge tangents over a million points would not fit in memory either.
+	 */
+	bool ShouldMeasure(const FString& Benchmark, SplineBenchmark::EShape Shape, int32 NumPoints);
+
+	/**
+	 * Repeats Run until -SplineBenchmarkMinSeconds passed, then counts the allocations of a few more untimed runs.
+	 * @param	Run		Returns the number of operations it did, which the time is divided by
+	 */
+	FSplineBenchmarkResult& Measure(const FString& Benchmark, SplineBenchmark::EShape Shape, int32 NumPoints, TFunctionRef<int64()> Run);
+
+	/** Writes the results, then reports regressions against the baseline to the test. */
+	void Finish(FAutomationTestBase& Test) const;
+
+private:
+	FString Name;
+	TArray<FSplineBenchmarkResult> Results;
+	TArray<FString> Skipped;
+};
@@ -0,0 +1,50 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Slate/SplineBuilder.h"
+#include "SplineBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineBuilderBenchmark, "WidgetSplineSystem.Benchmark.Builder",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSplineBuilderBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SplineBenchmark;
+
+	// Subdivides and extrudes every segment into brush geometry, the same way FSplineTessellation does. Time is per segment.
+	FSplineBenchmarkReport Report(TEXT("Builder"));
+	for (const EShape Shape : GetShapes())
+	{
+		for (const int32 NumPoints : GetPointCounts())
+		{
+			if (!Report.ShouldMeasure(TEXT("BuildBezierGeometry"), Shape, NumPoints))
+			{
+				break;
+			}
+
+			const FSlateSpline Spline = MakeSpline(Shape, NumPoints);
+			int64 NumVertices = 0;
+			FSplineBenchmarkResult& Result = Report.Measure(TEXT("BuildBezierGeometry"), Shape, NumPoints, [&]()
+			{
+				FSplineBuilder SplineBuilder(Spline.Brush.GetImageSize(), FSlateRenderTransform(), FColor::White);
+				for (int32 i = 0; i < Spline.Points.Num() - 1; i++)
+				{
+					SplineBuilder.BuildBezierGeometry(Spline.Points[i], Spline.Points[i + 1], Spline.bIsLinear);
+				}
+				SplineBuilder.Finish(false);
+
+				NumVertices = SplineBuilder.GetVertexArray().Num();
+				return NumPoints - 1;
+			});
+			Result.VerticesPerRun = NumVertices;
+			TestTrue(FString::Printf(TEXT("%s emits a strip along every segment"), LexToString(Shape)), NumVertices >= 2 * NumPoints);
+		}
+	}
+
+	Report.Finish(*this);
+	return true;
+}
+
+#endif
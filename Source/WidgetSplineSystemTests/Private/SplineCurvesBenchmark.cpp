@@ -0,0 +1,44 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Data/SlateSplineCurves.h"
+#include "Misc/AutomationTest.h"
+#include "SplineBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineCurvesBenchmark, "WidgetSplineSystem.Benchmark.Curves",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSplineCurvesBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SplineBenchmark;
+
+	// Curves are built from scratch, like the geometry registry does for every new spline. Time is per point.
+	FSplineBenchmarkReport Report(TEXT("Curves"));
+	for (const EShape Shape : GetShapes())
+	{
+		for (const int32 NumPoints : GetPointCounts())
+		{
+			if (!Report.ShouldMeasure(TEXT("UpdateSpline"), Shape, NumPoints))
+			{
+				break;
+			}
+
+			const FSlateSpline Spline = MakeSpline(Shape, NumPoints);
+			int32 NumCurvePoints = 0;
+			Report.Measure(TEXT("UpdateSpline"), Shape, NumPoints, [&]()
+			{
+				FSlateSplineCurves Curves;
+				Curves.UpdateSpline(Spline);
+				NumCurvePoints = Curves.Position.Points.Num();
+				return NumPoints;
+			});
+			TestEqual(FString::Printf(TEXT("%s curve points"), LexToString(Shape)), NumCurvePoints, NumPoints);
+		}
+	}
+
+	Report.Finish(*this);
+	return true;
+}
+
+#endif
@@ -0,0 +1,83 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "Editor.h"
+#include "ISinglePropertyView.h"
+#include "Modules/ModuleManager.h"
+#include "PropertyEditorModule.h"
+#include "SplineDataEditor.h"
+#include "SplineEditDelta.h"
+#include "SplineWidget.h"
+#include "UObject/StrongObjectPtr.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineDataEditorUndoTest, "WidgetSplineSystem.SplineDataEditor.Undo",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+namespace SplineDataEditorTest
+{
+	TArray<FVector2D> GetLocations(const USplineWidget& SplineWidget)
+	{
+		TArray<FVector2D> Locations;
+		for (const FSlateSplinePoint& Point : SplineWidget.SplineData.Points)
+		{
+			Locations.Add(Point.Location);
+		}
+		return Locations;
+	}
+}
+
+bool FSplineDataEditorUndoTest::RunTest(const FString& Parameters)
+{
+	using namespace SplineDataEditorTest;
+
+	if (!TestNotNull(TEXT("Editor"), GEditor))
+	{
+		return false;
+	}
+
+	const TStrongObjectPtr<USplineWidget> SplineWidget(NewObject<USplineWidget>(GetTransientPackage(), NAME_None, RF_Transactional));
+	SplineWidget->UpdateSpline();
+	const TArray<FVector2D> OriginalLocations = GetLocations(*SplineWidget);
+
+	// Edits go through a property handle, as they do in the details panel and the widget designer
+	FPropertyEditorModule& PropertyEditor = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	const TSharedPtr<ISinglePropertyView> PropertyView = PropertyEditor.CreateSingleProperty(SplineWidget.Get(), GET_MEMBER_NAME_CHECKED(USplineWidget, SplineData), FSinglePropertyParams());
+	const TSharedPtr<IPropertyHandle> PropertyHandle = PropertyView.IsValid() ? PropertyView->GetPropertyHandle() : nullptr;
+	if (!TestTrue(TEXT("Spline data has a property handle"), PropertyHandle.IsValid() && PropertyHandle->IsValidHandle()))
+	{
+		return false;
+	}
+	const TSharedRef<FSplineDataEditor> SplineDataEditor = MakeShared<FSplineDataEditor>(PropertyHandle.ToSharedRef());
+
+	// A drag of the first point, reported step by step and then committed
+	FSlateSplinePoint MovedPoint = SplineWidget->SplineData.Points[0];
+	MovedPoint.Location += FVector2D(50.0f, 25.0f);
+	const FSplineEditDelta Drag = FSplinePointEdit::MakeModify(0, SplineWidget->SplineData.Points[0], MovedPoint);
+	SplineDataEditor->ApplyInteractiveEdit(Drag);
+	SplineDataEditor->CommitEdit(Drag, FText::FromString(TEXT("Move")));
+	const TArray<FVector2D> MovedLocations = GetLocations(*SplineWidget);
+	TestEqual(TEXT("Drag moves the point"), MovedLocations[0], MovedPoint.Location);
+
+	// An inserted point, which reverting a snapshot on top of the delta would remove twice
+	const FSlateSplinePoint InsertedPoint(FVector2D(300.0f, 100.0f), FVector2D(1.0f, 0.0f));
+	SplineDataEditor->CommitEdit(FSplinePointEdit::MakeInsert(1, InsertedPoint), FText::FromString(TEXT("Insert")));
+	const TArray<FVector2D> InsertedLocations = GetLocations(*SplineWidget);
+	TestEqual(TEXT("Insert adds the point"), InsertedLocations.Num(), OriginalLocations.Num() + 1);
+
+	GEditor->UndoTransaction();
+	TestEqual(TEXT("Undo removes the inserted point only"), GetLocations(*SplineWidget), MovedLocations);
+	GEditor->UndoTransaction();
+	TestEqual(TEXT("Undo moves the point back"), GetLocations(*SplineWidget), OriginalLocations);
+
+	GEditor->RedoTransaction();
+	TestEqual(TEXT("Redo moves the point again"), GetLocations(*SplineWidget), MovedLocations);
+	GEditor->RedoTransaction();
+	TestEqual(TEXT("Redo inserts the point again"), GetLocations(*SplineWidget), InsertedLocations);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "SplineBenchmark.h"
+#include "SplineWidget.h"
+#include "SplineWidgetFunctionLibrary.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineQueryBenchmark, "WidgetSplineSystem.Benchmark.Queries",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace SplineQueryBenchmark
+{
+	/** Queries per run, spread evenly over the spline. */
+	constexpr int32 NumQueries = 1024;
+
+	/** Where the queries of a run are made, the same for every query function. */
+	struct FQueryInputs
+	{
+		TArray<float> InputKeys;
+		TArray<float> Distances;
+		TArray<int32> PointIndices;
+		TArray<FVector2D> Locations;
+	};
+
+	using FQueryFunction = TFunction<void(const USplineWidget*, const FQueryInputs&, int32)>;
+
+	FQueryInputs MakeInputs(const USplineWidget* SplineWidget)
+	{
+		const int32 NumPoints = SplineWidget->SplineData.Points.Num();
+		const float SplineLength = USplineWidgetFunctionLibrary::GetSplineLength(SplineWidget);
+		const FBox2D Bounds = SplineWidget->GetSplineCurves().Bounds;
+
+		FRandomStream RandomStream(1234);
+		FQueryInputs Inputs;
+		for (int32 i = 0; i < NumQueries; i++)
+		{
+			const float Alpha = (i + 0.5f) / NumQueries;
+			Inputs.InputKeys.Add(Alpha * (NumPoints - 1));
+			Inputs.Distances.Add(Alpha * SplineLength);
+			Inputs.PointIndices.Add(FMath::Min(FMath::FloorToInt(Alpha * NumPoints), NumPoints - 1));
+			Inputs.Locations.Emplace(RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X), RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+		}
+		return Inputs;
+	}
+
+	TArray<TPair<const TCHAR*, FQueryFunction>> MakeQueryFunctions()
+	{
+		using FLibrary = USplineWidgetFunctionLibrary;
+		constexpr ESlateSplineCoordinateSpace Local = ESlateSplineCoordinateSpace::Local;
+
+		TArray<TPair<const TCHAR*, FQueryFunction>> Functions;
+		Functions.Emplace(TEXT("GetSplineLength"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetSplineLength(Widget);
+		});
+		Functions.Emplace(TEXT("GetDistanceAlongSplineAtSplineInputKey"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetDistanceAlongSplineAtSplineInputKey(Widget, Inputs.InputKeys[i]);
+		});
+		Functions.Emplace(TEXT("GetLocationAtSplineInputKey"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetLocationAtSplineInputKey(Widget, Inputs.InputKeys[i], Local);
+		});
+		Functions.Emplace(TEXT("GetTangentAtSplineInputKey"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetTangentAtSplineInputKey(Widget, Inputs.InputKeys[i], Local);
+		});
+		Functions.Emplace(TEXT("GetDirectionAtSplineInputKey"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetDirectionAtSplineInputKey(Widget, Inputs.InputKeys[i], Local);
+		});
+		Functions.Emplace(TEXT("GetRotationAngleAtSplineInputKey"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetRotationAngleAtSplineInputKey(Widget, Inputs.InputKeys[i], Local);
+		});
+		Functions.Emplace(TEXT("GetLocationAtSplinePoint"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetLocationAtSplinePoint(Widget, Inputs.PointIndices[i], Local);
+		});
+		Functions.Emplace(TEXT("GetDirectionAtSplinePoint"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetDirectionAtSplinePoint(Widget, Inputs.PointIndices[i], Local);
+		});
+		Functions.Emplace(TEXT("GetTangentAtSplinePoint"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetTangentAtSplinePoint(Widget, Inputs.PointIndices[i], Local);
+		});
+		Functions.Emplace(TEXT("GetInputKeyAtDistanceAlongSpline"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetInputKeyAtDistanceAlongSpline(Widget, Inputs.Distances[i], Local);
+		});
+		Functions.Emplace(TEXT("GetLocationAtDistanceAlongSpline"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetLocationAtDistanceAlongSpline(Widget, Inputs.Distances[i], Local);
+		});
+		Functions.Emplace(TEXT("GetDirectionAtDistanceAlongSpline"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetDirectionAtDistanceAlongSpline(Widget, Inputs.Distances[i], Local);
+		});
+		Functions.Emplace(TEXT("GetTangentAtDistanceAlongSpline"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetTangentAtDistanceAlongSpline(Widget, Inputs.Distances[i], Local);
+		});
+		Functions.Emplace(TEXT("GetRotationAngleAtDistanceAlongSpline"), [](const USplineWidget* Widget, const FQueryInputs& Inputs, int32 i)
+		{
+			FLibrary::GetRotationAngleAtDistanceAlongSpline(Widget, Inputs.Distances[i], Local);
+		});
+		return Functions;
+	}
+}
+
+bool FSplineQueryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SplineBenchmark;
+	using namespace SplineQueryBenchmark;
+
+	const TArray<TPair<const TCHAR*, FQueryFunction>> QueryFunctions = MakeQueryFunctions();
+
+	// Time is per query. The curves are built before measuring, queries only read them.
+	FSplineBenchmarkReport Report(TEXT("Queries"));
+	for (const EShape Shape : GetShapes())
+	{
+		TSet<FString> SkippedBenchmarks;
+		for (const int32 NumPoints : GetPointCounts())
+		{
+			const TStrongObjectPtr<USplineWidget> SplineWidget(NewObject<USplineWidget>());
+			SplineWidget->SplineData = MakeSpline(Shape, NumPoints);
+			SplineWidget->UpdateSpline();
+			const FQueryInputs Inputs = MakeInputs(SplineWidget.Get());
+
+			for (const TPair<const TCHAR*, FQueryFunction>& QueryFunction : QueryFunctions)
+			{
+				if (SkippedBenchmarks.Contains(QueryFunction.Key) || !Report.ShouldMeasure(QueryFunction.Key, Shape, NumPoints))
+				{
+					SkippedBenchmarks.Add(QueryFunction.Key);
+					continue;
+				}
+
+				Report.Measure(QueryFunction.Key, Shape, NumPoints, [&]()
+				{
+					for (int32 i = 0; i < NumQueries; i++)
+					{
+						QueryFunction.Value(SplineWidget.Get(), Inputs, i);
+					}
+					return NumQueries;
+				});
+			}
+
+			// A single batch, which the library splits across worker threads
+			const TCHAR* ClosestPointsName = TEXT("FindClosestPointsOnSpline");
+			if (!SkippedBenchmarks.Contains(ClosestPointsName) && Report.ShouldMeasure(ClosestPointsName, Shape, NumPoints))
+			{
+				TArray<FVector2D> ClosestLocations;
+				TArray<float> InputKeys;
+				TArray<float> SignedDistances;
+				Report.Measure(ClosestPointsName, Shape, NumPoints, [&]()
+				{
+					USplineWidgetFunctionLibrary::FindClosestPointsOnSpline(SplineWidget.Get(), Inputs.Locations, ClosestLocations, InputKeys, SignedDistances);
+					return NumQueries;
+				});
+			}
+			else
+			{
+				SkippedBenchmarks.Add(ClosestPointsName);
+			}
+		}
+	}
+
+	Report.Finish(*this);
+	return true;
+}
+
+#endif
@@ -0,0 +1,71 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Slate/SplineGeometryRegistry.h"
+#include "Slate/SplineHitTester.h"
+#include "Slate/SplineTessellation.h"
+#include "SplineWidget.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineWidgetWidthEditTest, "WidgetSplineSystem.SplineWidget.WidthEdit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace SplineWidgetUpdateTest
+{
+	TArray<FVector2f> GetPositions(const TArray<FSlateVertex>& Vertices)
+	{
+		TArray<FVector2f> Positions;
+		Positions.Reserve(Vertices.Num());
+		for (const FSlateVertex& Vertex : Vertices)
+		{
+			Positions.Add(Vertex.Position);
+		}
+		return Positions;
+	}
+}
+
+bool FSplineWidgetWidthEditTest::RunTest(const FString& Parameters)
+{
+	using namespace SplineWidgetUpdateTest;
+
+	const TStrongObjectPtr<USplineWidget> SplineWidget(NewObject<USplineWidget>());
+	SplineWidget->SplineData.Brush.SetImageSize(FVector2D(8.0f));
+	SplineWidget->UpdateSpline();
+
+	const uint32 OldVersion = SplineWidget->GetSplineVersion();
+	const FSlateSplineCurves* OldCurves = SplineWidget->GetSplineCurvesPtr();
+	FSplineTessellation Tessellation;
+	Tessellation.Update(SplineWidget->SplineData, OldVersion, FColor::White);
+	const TArray<FVector2f> OldPositions = GetPositions(Tessellation.GetVertices());
+
+	// Beside the end of the stroke, which ends heading along X, outside its half thickness of 4 but within 16
+	const FVector2D NearEnd = SplineWidget->SplineData.Points[1].Location + FVector2D(0.0f, 10.0f);
+	const float BrushWidth = SplineWidget->SplineData.Brush.GetImageSize().X;
+	FSplineHitTester HitTester;
+	FSplineHitResult Hit;
+	HitTester.Build(SplineWidget->GetSplineCurves(), SplineWidget->SplineData, OldVersion);
+	TestFalse(TEXT("Stroke is missed beside its end before the width changes"), HitTester.HitTest(NearEnd, 0.0f, Hit));
+
+	// Widths are not part of the curves, so the widget keeps sharing the same ones
+	SplineWidget->SplineData.Points[1].Width = 4.0f;
+	SplineWidget->UpdateSpline();
+
+	const uint32 NewVersion = SplineWidget->GetSplineVersion();
+	TestEqual(TEXT("Curves are kept when only a width changes"), SplineWidget->GetSplineCurvesPtr(), OldCurves);
+	TestNotEqual(TEXT("Version changes when only a width changes"), NewVersion, OldVersion);
+
+	Tessellation.Update(SplineWidget->SplineData, NewVersion, FColor::White);
+	TestNotEqual(TEXT("Geometry changes when only a width changes"), GetPositions(Tessellation.GetVertices()), OldPositions);
+	TestTrue(TEXT("Geometry is the registry entry of the new widths"),
+		&Tessellation.GetVertices() == &FSplineGeometryRegistry::Get().FindOrAddGeometry(SplineWidget->SplineData, FColor::White)->Vertices);
+
+	TestFalse(TEXT("Hit tester is stale when only a width changes"), HitTester.IsBuiltFor(NewVersion, BrushWidth));
+	HitTester.Build(SplineWidget->GetSplineCurves(), SplineWidget->SplineData, NewVersion);
+	TestTrue(TEXT("Stroke is hit beside its end once widened"), HitTester.HitTest(NearEnd, 0.0f, Hit));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,5 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, WidgetSplineSystemTests)
@@ -0,0 +1,35 @@
+// Copyright to Kat Code Labs, SRL. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class WidgetSplineSystemTests : ModuleRules
+{
+	public WidgetSplineSystemTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"Slate",
+				"SlateCore",
+				"UMG",
+				"WidgetSplineSystem"
+			});
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"PropertyEditor",
+					"UnrealEd",
+					"WidgetSplineSystemEditor"
+				});
+		}
+	}
+}